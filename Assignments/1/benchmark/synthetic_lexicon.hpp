@@ -0,0 +1,51 @@
+#ifndef COMP6771_SYNTHETIC_LEXICON_HPP
+#define COMP6771_SYNTHETIC_LEXICON_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "absl/container/flat_hash_set.h"
+
+namespace word_ladder::benchmark {
+	// What a synthetic lexicon looks like. Words are drawn uniformly from the first `alphabet`
+	// lowercase letters, so for a given word count a smaller alphabet (or shorter words) packs the
+	// word graph more densely: more neighbours per word, more ladders per pair. `noise` extra words
+	// of other lengths are mixed in, as in a real dictionary.
+	struct lexicon_spec {
+		std::size_t words = 1 << 12;
+		std::size_t length = 5;
+		std::size_t alphabet = 26;
+		std::size_t noise = 0;
+		std::uint64_t seed = 6771;
+	};
+
+	// The same spec always gives the same lexicon. Pre: the spec asks for no more distinct words
+	// than alphabet^length.
+	inline auto synthetic_lexicon(lexicon_spec const& spec) -> absl::flat_hash_set<std::string> {
+		auto rng = std::mt19937_64(spec.seed);
+		auto letter = std::uniform_int_distribution<int>(0, static_cast<int>(spec.alphabet) - 1);
+		auto make_word = [&](std::size_t length) {
+			auto word = std::string(length, 'a');
+			for (auto& c : word) {
+				c = static_cast<char>('a' + letter(rng));
+			}
+			return word;
+		};
+
+		auto lexicon = absl::flat_hash_set<std::string>{};
+		while (lexicon.size() < spec.words) {
+			lexicon.insert(make_word(spec.length));
+		}
+		auto other_length = std::uniform_int_distribution<std::size_t>(2, spec.length + 4);
+		for (auto i = std::size_t{0}; i < spec.noise; ++i) {
+			if (auto const length = other_length(rng); length != spec.length) {
+				lexicon.insert(make_word(length));
+			}
+		}
+		return lexicon;
+	}
+} // namespace word_ladder::benchmark
+
+#endif // COMP6771_SYNTHETIC_LEXICON_HPP
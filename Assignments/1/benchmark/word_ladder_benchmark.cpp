@@ -0,0 +1,274 @@
+// Benchmarks for each phase of the ladder search and for whole queries over a mix of pairs.
+//
+// Run with --benchmark_format=json (or --benchmark_out=results.json --benchmark_out_format=json)
+// for machine-readable results. Every benchmark takes {words, length, alphabet} as its first
+// three arguments, so the same phase can be compared across lexicon sizes and densities.
+#include <benchmark/benchmark.h>
+#include <range/v3/algorithm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "comp6771/distance_oracle.hpp"
+#include "comp6771/interned_lexicon.hpp"
+#include "comp6771/ladder_search.hpp"
+#include "comp6771/pattern_index.hpp"
+#include "comp6771/solver.hpp"
+#include "comp6771/word_ladder.hpp"
+#include "synthetic_lexicon.hpp"
+
+namespace {
+	using word_ladder::benchmark::lexicon_spec;
+	using word_ladder::benchmark::synthetic_lexicon;
+	using query = std::pair<std::string, std::string>;
+
+	// The kinds of query a benchmark can run
+	enum class mix { easy, hard, unreachable, many_ladders };
+
+	auto spec_of(benchmark::State const& state) -> lexicon_spec {
+		auto spec = lexicon_spec{};
+		spec.words = static_cast<std::size_t>(state.range(0));
+		spec.length = static_cast<std::size_t>(state.range(1));
+		spec.alphabet = static_cast<std::size_t>(state.range(2));
+		spec.noise = spec.words / 4;
+		return spec;
+	}
+
+	// A lexicon, a solver over it and a few queries of each kind, built once per spec
+	struct fixture {
+		explicit fixture(lexicon_spec const& spec)
+		: lexicon(synthetic_lexicon(spec))
+		, solver(lexicon) {
+			auto const index = solver.index(spec.length);
+			auto const oracle = word_ladder::distance_oracle(*index);
+			auto rng = std::mt19937_64(spec.seed);
+			auto pick = std::uniform_int_distribution<word_ladder::word_id>(
+			   0,
+			   static_cast<word_ladder::word_id>(index->size() - 1));
+			auto word = [&](word_ladder::word_id id) { return std::string(index->word(id)); };
+
+			// Easy: a word and somewhere one or two steps along a random walk from it
+			for (auto tries = 0; tries < 10'000 and queries(mix::easy).size() < sample; ++tries) {
+				auto const from = pick(rng);
+				auto to = from;
+				for (auto step = 0; step < 2; ++step) {
+					auto next = std::vector<word_ladder::word_id>{};
+					index->for_each_neighbour(to, [&next](word_ladder::word_id n) { next.push_back(n); });
+					if (!next.empty()) {
+						to = next[rng() % next.size()];
+					}
+				}
+				if (to != from) {
+					queries(mix::easy).emplace_back(word(from), word(to));
+				}
+			}
+
+			// The rest come from random pairs, ranked by distance or by number of ladders
+			auto reachable = std::vector<std::pair<std::uint32_t, query>>{};
+			for (auto tries = std::size_t{0}; tries < 64 * sample; ++tries) {
+				auto const from = pick(rng);
+				auto const to = pick(rng);
+				if (!index->connected(from, to)) {
+					if (queries(mix::unreachable).size() < sample) {
+						queries(mix::unreachable).emplace_back(word(from), word(to));
+					}
+				}
+				else if (from != to) {
+					reachable.emplace_back(oracle.distance(from, to), query(word(from), word(to)));
+				}
+			}
+			ranges::sort(reachable, std::greater<>(), [](auto const& r) { return r.first; });
+			for (auto i = std::size_t{0}; i < std::min(sample, reachable.size()); ++i) {
+				queries(mix::hard).push_back(reachable[i].second);
+			}
+
+			auto counted = std::vector<std::pair<std::uint64_t, query>>{};
+			for (auto const& [distance, q] : reachable) {
+				counted.emplace_back(solver.count_ladders(q.first, q.second), q);
+			}
+			ranges::sort(counted, std::greater<>(), [](auto const& c) { return c.first; });
+			for (auto i = std::size_t{0}; i < std::min(sample, counted.size()); ++i) {
+				queries(mix::many_ladders).push_back(counted[i].second);
+			}
+		}
+
+		auto queries(mix m) -> std::vector<query>& {
+			return by_mix[static_cast<std::size_t>(m)];
+		}
+
+		static constexpr auto sample = std::size_t{32};
+		absl::flat_hash_set<std::string> lexicon;
+		word_ladder::solver solver;
+		std::array<std::vector<query>, 4> by_mix;
+	};
+
+	auto fixture_for(benchmark::State const& state) -> fixture& {
+		static auto fixtures = std::map<std::array<std::int64_t, 3>, std::unique_ptr<fixture>>{};
+		auto& slot = fixtures[{state.range(0), state.range(1), state.range(2)}];
+		if (slot == nullptr) {
+			slot = std::make_unique<fixture>(spec_of(state));
+		}
+		return *slot;
+	}
+
+	auto mode_of(std::int64_t arg) -> word_ladder::search_mode {
+		return arg == 0 ? word_ladder::search_mode::forward : word_ladder::search_mode::bidirectional;
+	}
+
+	auto BM_read_lexicon(benchmark::State& state) -> void {
+		auto const& lexicon = fixture_for(state).lexicon;
+		auto const path = (std::filesystem::temp_directory_path() / "word_ladder_benchmark.txt").string();
+		{
+			auto out = std::ofstream(path);
+			for (auto const& word : lexicon) {
+				out << word << '\n';
+			}
+		}
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(word_ladder::read_lexicon(path));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(lexicon.size()));
+		std::filesystem::remove(path);
+	}
+
+	// Pulling out the words of one length and interning them, as generate does on every call
+	auto BM_extract_same_length(benchmark::State& state) -> void {
+		auto const& lexicon = fixture_for(state).lexicon;
+		auto const length = static_cast<std::size_t>(state.range(1));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(word_ladder::interned_lexicon(lexicon, length));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(lexicon.size()));
+	}
+
+	auto BM_build_pattern_index(benchmark::State& state) -> void {
+		auto const& lexicon = fixture_for(state).lexicon;
+		auto const length = static_cast<std::size_t>(state.range(1));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(word_ladder::pattern_index(word_ladder::interned_lexicon(lexicon, length)));
+		}
+	}
+
+	// The BFS alone, over the hard queries
+	auto BM_bfs(benchmark::State& state) -> void {
+		auto& f = fixture_for(state);
+		auto const index = f.solver.index(static_cast<std::size_t>(state.range(1)));
+		auto const mode = mode_of(state.range(3));
+		auto const& queries = f.queries(mix::hard);
+		if (queries.empty()) {
+			state.SkipWithError("The lexicon has no reachable pairs");
+			return;
+		}
+		auto scratch = word_ladder::detail::search_scratch{};
+		auto i = std::size_t{0};
+		for (auto _ : state) {
+			auto const& [from, to] = queries[i++ % queries.size()];
+			word_ladder::detail::explore(*index->find(from), *index->find(to), *index, mode, scratch);
+			benchmark::DoNotOptimize(scratch.level.data());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	// Walking every ladder out of an already-built DAG, over the many-ladder queries
+	auto BM_enumerate(benchmark::State& state) -> void {
+		auto& f = fixture_for(state);
+		auto ranges = std::vector<word_ladder::ladder_range>{};
+		for (auto const& [from, to] : f.queries(mix::many_ladders)) {
+			ranges.push_back(f.solver.ladders(from, to));
+		}
+		if (ranges.empty()) {
+			state.SkipWithError("The lexicon has no reachable pairs");
+			return;
+		}
+		auto ladders = std::int64_t{0};
+		auto i = std::size_t{0};
+		for (auto _ : state) {
+			for (auto const& ladder : ranges[i++ % ranges.size()]) {
+				benchmark::DoNotOptimize(ladder.data());
+				++ladders;
+			}
+		}
+		state.SetItemsProcessed(ladders);
+		state.counters["ladders"] = benchmark::Counter(static_cast<double>(ladders),
+		                                               benchmark::Counter::kAvgIterations);
+	}
+
+	// Whole generate calls over one kind of query
+	auto BM_generate(benchmark::State& state) -> void {
+		auto& f = fixture_for(state);
+		auto const& queries = f.queries(static_cast<mix>(state.range(4)));
+		if (queries.empty()) {
+			state.SkipWithError("The lexicon has no queries of this kind");
+			return;
+		}
+		auto const mode = mode_of(state.range(3));
+		auto ladders = std::int64_t{0};
+		auto i = std::size_t{0};
+		for (auto _ : state) {
+			auto const& [from, to] = queries[i++ % queries.size()];
+			auto const result = f.solver.generate(from, to, mode);
+			ladders += static_cast<std::int64_t>(result.size());
+			benchmark::DoNotOptimize(result.data());
+		}
+		state.SetItemsProcessed(state.iterations());
+		state.counters["ladders"] = benchmark::Counter(static_cast<double>(ladders),
+		                                               benchmark::Counter::kAvgIterations);
+	}
+
+	// {words, length, alphabet}: a sparse lexicon near the point where it falls apart into many
+	// components (long ladders, many unreachable pairs), a dense one (short ladders, lots of them)
+	// and a large one in between
+	constexpr auto shapes = std::array<std::array<std::int64_t, 3>, 3>{{
+	   {1 << 12, 5, 10},
+	   {1 << 12, 4, 9},
+	   {1 << 15, 6, 8},
+	}};
+
+	auto lexicons(benchmark::internal::Benchmark* b) -> void {
+		b->ArgNames({"words", "length", "alphabet"});
+		for (auto const& [words, length, alphabet] : shapes) {
+			b->Args({words, length, alphabet});
+		}
+	}
+
+	auto searches(benchmark::internal::Benchmark* b) -> void {
+		b->ArgNames({"words", "length", "alphabet", "bidirectional"});
+		for (auto const mode : {0, 1}) {
+			for (auto const& [words, length, alphabet] : shapes) {
+				b->Args({words, length, alphabet, mode});
+			}
+		}
+	}
+
+	auto query_mixes(benchmark::internal::Benchmark* b) -> void {
+		b->ArgNames({"words", "length", "alphabet", "bidirectional", "mix"});
+		for (auto const m : {mix::easy, mix::hard, mix::unreachable, mix::many_ladders}) {
+			for (auto const mode : {0, 1}) {
+				for (auto const& [words, length, alphabet] : shapes) {
+					b->Args({words, length, alphabet, mode, static_cast<std::int64_t>(m)});
+				}
+			}
+		}
+	}
+} // namespace
+
+BENCHMARK(BM_read_lexicon)->Apply(lexicons)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_extract_same_length)->Apply(lexicons)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_build_pattern_index)->Apply(lexicons)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_bfs)->Apply(searches)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_enumerate)->Apply(lexicons)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_generate)->Apply(query_mixes)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,117 @@
+#ifndef COMP6771_ALPHABET_HPP
+#define COMP6771_ALPHABET_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Alphabet policies: the characters the neighbour search tries at each position of a word. A
+// policy is anything with a for_each(f) that calls f(c) once per character c in the alphabet.
+namespace word_ladder {
+	template<typename A>
+	concept alphabet_policy = requires(A const& alphabet) {
+		alphabet.for_each([](char) {});
+	};
+
+	// A fixed alphabet known at compile time. for_each expands to one call per letter with no
+	// loop at all, which suits small alphabets best.
+	template<char... Letters>
+	struct alphabet {
+		static constexpr auto letters = std::array<char, sizeof...(Letters)>{Letters...};
+
+		[[nodiscard]] static constexpr auto contains(char c) noexcept -> bool {
+			return ((c == Letters) or ...);
+		}
+
+		template<typename F>
+		static constexpr auto for_each(F&& f) -> void {
+			(f(Letters), ...);
+		}
+	};
+
+	namespace detail {
+		template<char First, typename Offsets>
+		struct letter_range;
+
+		template<char First, std::size_t... Offsets>
+		struct letter_range<First, std::index_sequence<Offsets...>> {
+			using type = alphabet<static_cast<char>(First + Offsets)...>;
+		};
+
+		template<typename... Alphabets>
+		struct join;
+
+		template<char... Letters>
+		struct join<alphabet<Letters...>> {
+			using type = alphabet<Letters...>;
+		};
+
+		template<char... Left, char... Right, typename... Rest>
+		struct join<alphabet<Left...>, alphabet<Right...>, Rest...> {
+			using type = typename join<alphabet<Left..., Right...>, Rest...>::type;
+		};
+	} // namespace detail
+
+	// The letters First, First + 1, ..., Last
+	template<char First, char Last>
+	using letter_range = typename detail::
+	   letter_range<First, std::make_index_sequence<static_cast<std::size_t>(Last - First + 1)>>::type;
+
+	// Every letter of each alphabet in turn
+	template<typename... Alphabets>
+	using join = typename detail::join<Alphabets...>::type;
+
+	using lowercase = letter_range<'a', 'z'>;
+	using uppercase = letter_range<'A', 'Z'>;
+	using digits = letter_range<'0', '9'>;
+	using alphanumeric = join<digits, uppercase, lowercase>;
+
+	// Any set of byte values, decided at run time. This is the alphabet a lexicon declares for
+	// itself: the bytes its words actually contain, which may include digits, capitals or bytes
+	// outside ASCII. for_each only visits members, in ascending order of unsigned byte value.
+	class byte_set {
+	public:
+		constexpr byte_set() noexcept = default;
+
+		constexpr auto insert(char c) noexcept -> void {
+			auto const b = static_cast<unsigned char>(c);
+			bits_[b / 64] |= std::uint64_t{1} << (b % 64);
+		}
+
+		[[nodiscard]] constexpr auto contains(char c) const noexcept -> bool {
+			auto const b = static_cast<unsigned char>(c);
+			return ((bits_[b / 64] >> (b % 64)) & 1) != 0;
+		}
+
+		constexpr auto operator|=(byte_set const& other) noexcept -> byte_set& {
+			for (auto i = std::size_t{0}; i < bits_.size(); ++i) {
+				bits_[i] |= other.bits_[i];
+			}
+			return *this;
+		}
+
+		[[nodiscard]] constexpr auto empty() const noexcept -> bool {
+			return (bits_[0] | bits_[1] | bits_[2] | bits_[3]) == 0;
+		}
+
+		template<typename F>
+		constexpr auto for_each(F&& f) const -> void {
+			for (auto word = std::size_t{0}; word < bits_.size(); ++word) {
+				for (auto bits = bits_[word]; bits != 0; bits &= bits - 1) {
+					auto const b = word * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+					f(static_cast<char>(b));
+				}
+			}
+		}
+
+		[[nodiscard]] friend constexpr auto operator==(byte_set const&, byte_set const&) noexcept
+		   -> bool = default;
+
+	private:
+		std::array<std::uint64_t, 4> bits_ = {};
+	};
+} // namespace word_ladder
+
+#endif // COMP6771_ALPHABET_HPP
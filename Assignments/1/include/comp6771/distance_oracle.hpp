@@ -0,0 +1,60 @@
+#ifndef COMP6771_DISTANCE_ORACLE_HPP
+#define COMP6771_DISTANCE_ORACLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "comp6771/pattern_index.hpp"
+
+namespace word_ladder {
+	// Ladder distances between words of one length, answered from precomputed landmarks. Building
+	// the oracle runs one BFS from each of a few well-spread landmark words and keeps every word's
+	// distance to each of them. By the triangle inequality these give a lower and an upper bound on
+	// any distance; when the two agree that is the answer, and otherwise a search that skips every
+	// word the lower bound rules out closes the gap. The oracle refers to index, which must outlive it.
+	class distance_oracle {
+	public:
+		// Distances count steps, so a word is 0 from itself and 1 from each of its neighbours
+		static constexpr auto unreachable = std::numeric_limits<std::uint32_t>::max();
+
+		explicit distance_oracle(pattern_index const& index, std::size_t landmarks = 16);
+
+		[[nodiscard]] auto index() const noexcept -> pattern_index const& {
+			return *index_;
+		}
+		// The landmark words, in the order they were chosen
+		[[nodiscard]] auto landmarks() const noexcept -> std::span<word_id const> {
+			return landmarks_;
+		}
+
+		// No ladder between a and b is shorter than this; unreachable if they are not connected
+		[[nodiscard]] auto lower_bound(word_id a, word_id b) const noexcept -> std::uint32_t;
+		// Some ladder between a and b is no longer than this, or unreachable if the landmarks know
+		// of none
+		[[nodiscard]] auto upper_bound(word_id a, word_id b) const noexcept -> std::uint32_t;
+
+		// The exact number of steps on a shortest ladder between a and b, or unreachable
+		[[nodiscard]] auto distance(word_id a, word_id b) const -> std::uint32_t;
+		// As above, or std::nullopt if either word is missing or there is no ladder between them
+		[[nodiscard]] auto distance(std::string_view from, std::string_view to) const
+		   -> std::optional<std::size_t>;
+
+	private:
+		[[nodiscard]] auto row(word_id id) const noexcept -> std::span<std::uint32_t const> {
+			return std::span(distances_).subspan(std::size_t{id} * landmarks_.size(), landmarks_.size());
+		}
+
+		pattern_index const* index_;
+		std::vector<word_id> landmarks_;
+		// distances_[id * landmarks_.size() + l] is id's distance to landmark l, so all of one word's
+		// distances sit together
+		std::vector<std::uint32_t> distances_;
+	};
+} // namespace word_ladder
+
+#endif // COMP6771_DISTANCE_ORACLE_HPP
@@ -0,0 +1,92 @@
+#ifndef COMP6771_FLAT_ARRAY_HPP
+#define COMP6771_FLAT_ARRAY_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace word_ladder {
+	// An array that either owns its elements or borrows them from memory that outlives it, such as
+	// a mapped lexicon file. Either way the elements are contiguous, so the index structures built
+	// on it look the same whether they were built or loaded. It is read-only except through edit().
+	template<typename T>
+	class flat_array {
+	public:
+		flat_array() = default;
+		explicit flat_array(std::vector<T> owned) noexcept
+		: owned_(std::move(owned))
+		, view_(owned_) {}
+		explicit flat_array(std::span<T const> borrowed) noexcept
+		: view_(borrowed) {}
+
+		// A copy always owns its elements, even if the original borrows them. Moving a vector keeps
+		// its buffer, so a moved-to array can take over the view as it is.
+		flat_array(flat_array const& other)
+		: owned_(other.begin(), other.end())
+		, view_(owned_) {}
+		flat_array(flat_array&& other) noexcept
+		: owned_(std::move(other.owned_))
+		, view_(std::exchange(other.view_, {})) {}
+		auto operator=(flat_array const& other) -> flat_array& {
+			if (this != &other) {
+				owned_.assign(other.begin(), other.end());
+				view_ = owned_;
+			}
+			return *this;
+		}
+		auto operator=(flat_array&& other) noexcept -> flat_array& {
+			owned_ = std::move(other.owned_);
+			view_ = std::exchange(other.view_, {});
+			return *this;
+		}
+		~flat_array() = default;
+
+		// The elements, for changing in place. A borrowed array is copied into one of its own first,
+		// once; an owned one is changed where it is.
+		[[nodiscard]] auto edit() -> std::span<T> {
+			own();
+			return owned_;
+		}
+		// As above, calling f(elements) with them as a vector that f may also grow or shrink
+		template<std::invocable<std::vector<T>&> F>
+		auto edit(F&& f) -> void {
+			own();
+			std::forward<F>(f)(owned_);
+			view_ = owned_;
+		}
+
+		[[nodiscard]] auto operator[](std::size_t i) const noexcept -> T const& {
+			return view_[i];
+		}
+		[[nodiscard]] auto data() const noexcept -> T const* {
+			return view_.data();
+		}
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return view_.size();
+		}
+		[[nodiscard]] auto span() const noexcept -> std::span<T const> {
+			return view_;
+		}
+		[[nodiscard]] auto begin() const noexcept {
+			return view_.begin();
+		}
+		[[nodiscard]] auto end() const noexcept {
+			return view_.end();
+		}
+
+	private:
+		auto own() -> void {
+			if (view_.data() != owned_.data() or view_.size() != owned_.size()) {
+				owned_.assign(view_.begin(), view_.end());
+				view_ = owned_;
+			}
+		}
+
+		std::vector<T> owned_;
+		std::span<T const> view_;
+	};
+} // namespace word_ladder
+
+#endif // COMP6771_FLAT_ARRAY_HPP
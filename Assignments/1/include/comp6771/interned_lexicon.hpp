@@ -0,0 +1,204 @@
+#ifndef COMP6771_INTERNED_LEXICON_HPP
+#define COMP6771_INTERNED_LEXICON_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/string_view.h"
+#include "comp6771/alphabet.hpp"
+#include "comp6771/flat_array.hpp"
+#include "comp6771/perfect_hash.hpp"
+
+namespace word_ladder {
+	using word_id = std::uint32_t;
+
+	// The words of one length in a lexicon, numbered 0, 1, 2, ... in lexicographic order. Since
+	// every word has the same length, comparing IDs is the same as comparing the words themselves.
+	// The words live back to back in one buffer, and a perfect hash maps each word to its ID.
+	//
+	// insert and erase change the lexicon in place without renumbering anyone: a new word takes
+	// the next ID, and an erased word leaves its ID unused until the same word comes back. So
+	// after updates IDs may have gaps, and may no longer follow the order of the words; ordered()
+	// says which.
+	class interned_lexicon {
+	public:
+		interned_lexicon(absl::flat_hash_set<std::string> const& lexicon, std::size_t length);
+		// Pre: every word in words has the given length. Repeated words are only interned once.
+		interned_lexicon(std::vector<std::string_view> words, std::size_t length);
+		// Reassembles a lexicon from the parts another one exposes through chars(), lookup() and
+		// positions(), without reading the words again
+		interned_lexicon(std::size_t length,
+		                 flat_array<char> chars,
+		                 perfect_hash lookup,
+		                 flat_array<byte_set> positions);
+
+		// Adds word and returns its ID: the one it had before if it was erased, else the next one
+		// after every ID in use. The perfect hash is left as it is; words it was not built over are
+		// looked up in a table beside it. Pre: word has length() characters and is not in the lexicon
+		auto insert(std::string_view word) -> word_id;
+		// Removes the word `id`. Its characters stay where they are, so its ID is not reused for
+		// another word, and the letter sets still count its letters. Pre: contains(id)
+		auto erase(word_id id) -> void;
+
+		[[nodiscard]] auto length() const noexcept -> std::size_t {
+			return length_;
+		}
+		// One past the largest ID given out, erased words included, so arrays indexed by ID need
+		// this many entries
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return length_ == 0 ? 0 : chars_.size() / length_;
+		}
+		// How many words are in the lexicon
+		[[nodiscard]] auto word_count() const noexcept -> std::size_t {
+			return word_count_;
+		}
+		[[nodiscard]] auto contains(word_id id) const noexcept -> bool {
+			return id < size() and (id >= erased_.size() or not erased_[id]);
+		}
+		// Whether comparing IDs is still the same as comparing words; it stops being so once a word
+		// is inserted that sorts before one that is already there
+		[[nodiscard]] auto ordered() const noexcept -> bool {
+			return ordered_;
+		}
+		[[nodiscard]] auto word(word_id id) const noexcept -> std::string_view {
+			return {chars_.data() + std::size_t{id} * length_, length_};
+		}
+		[[nodiscard]] auto find(std::string_view word) const noexcept -> std::optional<word_id> {
+			auto const id = interned(word);
+			if (!id or not contains(*id)) {
+				return std::nullopt;
+			}
+			return id;
+		}
+
+		[[nodiscard]] auto chars() const noexcept -> std::span<char const> {
+			return chars_.span();
+		}
+		[[nodiscard]] auto lookup() const noexcept -> perfect_hash const& {
+			return lookup_;
+		}
+		// positions()[p] is letters_at(p)
+		[[nodiscard]] auto positions() const noexcept -> std::span<byte_set const> {
+			return positions_.span();
+		}
+		// Every character that appears in some word, or in an erased one (see erase)
+		[[nodiscard]] auto alphabet() const noexcept -> byte_set const& {
+			return alphabet_;
+		}
+		// Every character that appears at position p of some word, or of an erased one
+		[[nodiscard]] auto letters_at(std::size_t p) const noexcept -> byte_set const& {
+			return positions_[p];
+		}
+
+		// Calls f(n) for every word n that differs from `id` in exactly one position, found by trying
+		// every letter of `letters` at every position against the lexicon. A letter that no word has
+		// at that position cannot make a word, so it is skipped without a lookup.
+		template<alphabet_policy Alphabet, typename F>
+		auto for_each_neighbour(word_id id, Alphabet const& letters, F&& f) const -> void {
+			for_each_neighbour(id, letters, f, [] {});
+		}
+
+		// As above, calling probed() before each lookup
+		template<alphabet_policy Alphabet, typename F, std::invocable Probed>
+		auto for_each_neighbour(word_id id, Alphabet const& letters, F&& f, Probed&& probed) const
+		   -> void {
+			probe(
+			   id,
+			   [&](std::size_t p, auto const& try_letter) {
+				   letters.for_each([&](char c) {
+					   if (positions_[p].contains(c)) {
+						   try_letter(c);
+					   }
+				   });
+			   },
+			   f,
+			   probed);
+		}
+
+		// As above, trying only the letters some word has at each position
+		template<typename F>
+		auto for_each_neighbour(word_id id, F&& f) const -> void {
+			for_each_neighbour(id, f, [] {});
+		}
+
+		template<typename F, std::invocable Probed>
+		auto for_each_neighbour(word_id id, F&& f, Probed&& probed) const -> void {
+			probe(
+			   id,
+			   [this](std::size_t p, auto const& try_letter) { positions_[p].for_each(try_letter); },
+			   f,
+			   probed);
+		}
+
+	private:
+		// The ID word has in chars_, whether or not it has been erased since
+		[[nodiscard]] auto interned(std::string_view word) const noexcept -> std::optional<word_id> {
+			if (auto const id = lookup_.lookup(word); id < size() and this->word(id) == word) {
+				return id;
+			}
+			if (added_.empty()) {
+				return std::nullopt;
+			}
+			auto const it = added_.find(absl::string_view(word.data(), word.size()));
+			return it == added_.end() ? std::nullopt : std::optional<word_id>(it->second);
+		}
+
+		// Calls f(n) for every word n made by putting one of the letters for_each_letter(p, g) passes
+		// to g at some position p of id's word
+		template<typename ForEachLetter, typename F, typename Probed>
+		auto probe(word_id id, ForEachLetter const& for_each_letter, F& f, Probed& probed) const
+		   -> void {
+			// Borrow this thread's buffer for the candidates and hand it back at the end, so a search
+			// only allocates for it when it meets longer words than this thread has probed before. A
+			// probe started from inside f finds the buffer taken and starts an empty one of its own.
+			auto new_curr = std::move(probe_buffer());
+			new_curr.assign(word(id));
+			for (auto p = std::size_t{0}; p < length_; ++p) // Each time replace one character
+			{
+				auto& ch = new_curr[p];
+				auto const old_ch = ch;
+				for_each_letter(p, [&](char c) {
+					if (c == old_ch) {
+						return;
+					}
+					ch = c;
+					probed();
+					if (auto const n = find(new_curr)) {
+						f(*n);
+					}
+				});
+				ch = old_ch; // Roll back the revised character
+			}
+			probe_buffer() = std::move(new_curr);
+		}
+
+		static auto probe_buffer() -> std::string& {
+			thread_local auto buffer = std::string();
+			return buffer;
+		}
+
+		std::size_t length_;
+		flat_array<char> chars_;
+		perfect_hash lookup_;
+		// positions_[p] holds the letters found at position p; alphabet_ is all of them together
+		flat_array<byte_set> positions_;
+		byte_set alphabet_;
+		// IDs of the words inserted since lookup_ was built
+		absl::flat_hash_map<std::string, word_id> added_;
+		// erased_[id] is set for every erased ID; IDs past its end have not been erased
+		std::vector<bool> erased_;
+		std::size_t word_count_ = 0;
+		bool ordered_ = true;
+	};
+} // namespace word_ladder
+
+#endif // COMP6771_INTERNED_LEXICON_HPP
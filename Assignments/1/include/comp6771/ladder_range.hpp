@@ -0,0 +1,164 @@
+#ifndef COMP6771_LADDER_RANGE_HPP
+#define COMP6771_LADDER_RANGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "comp6771/interned_lexicon.hpp"
+
+namespace word_ladder {
+	namespace detail {
+		// The words that lie on some shortest ladder, numbered 0, 1, 2, ... in order of their
+		// distance from `to`, with the edges between them stored compactly: children[first[v],
+		// first[v + 1]) are the words one step further from `from` than v, in ascending order. Every
+		// walk along children from `from` ends at `to`.
+		struct ladder_dag {
+			std::vector<word_id> nodes;
+			std::vector<std::uint32_t> first;
+			std::vector<std::uint32_t> children;
+			std::uint32_t from = 0;
+			std::uint32_t to = 0;
+		};
+
+		// A depth-first walk over every path from `from` to `to` in a ladder_dag, taking children in
+		// order, so the paths come out in lexicographic order. The walk keeps its own stack of steps
+		// rather than recursing, so a ladder of any length costs one small frame per word, and each
+		// step only reads the child ranges laid out in the DAG.
+		class ladder_walk {
+		public:
+			// Move to the first path in dag, which must outlive the walk
+			auto start(ladder_dag const& dag) -> void {
+				dag_ = &dag;
+				stack_.clear();
+				changed_ = 0;
+				if (!dag.nodes.empty()) {
+					stack_.push_back({dag.from, dag.first[dag.from]});
+					descend();
+				}
+			}
+
+			// Move to the next path, if there is one
+			auto advance() -> void {
+				// Drop `to`, then every step that has run out of children; the step left on top moves
+				// on to its next child
+				stack_.pop_back();
+				while (!stack_.empty() and stack_.back().next == dag_->first[stack_.back().node + 1]) {
+					stack_.pop_back();
+				}
+				if (!stack_.empty()) {
+					changed_ = stack_.size();
+					descend();
+				}
+			}
+
+			[[nodiscard]] auto done() const noexcept -> bool {
+				return stack_.empty();
+			}
+			// The number of words in the current path
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return stack_.size();
+			}
+			// The i-th word of the current path
+			[[nodiscard]] auto word(std::size_t i) const noexcept -> word_id {
+				return dag_->nodes[stack_[i].node];
+			}
+			// Words [0, changed()) of the current path are the same as in the last one
+			[[nodiscard]] auto changed() const noexcept -> std::size_t {
+				return changed_;
+			}
+
+		private:
+			// One step of the path: the word, and the next of its children to try
+			struct frame {
+				std::uint32_t node;
+				std::uint32_t next;
+			};
+
+			// Follow first children down from the top of the stack to `to`
+			auto descend() -> void {
+				while (stack_.back().node != dag_->to) {
+					auto const child = dag_->children[stack_.back().next++];
+					stack_.push_back({child, dag_->first[child]});
+				}
+			}
+
+			ladder_dag const* dag_ = nullptr;
+			std::vector<frame> stack_;
+			std::size_t changed_ = 0;
+		};
+	} // namespace detail
+
+	// Every shortest ladder between two words, in lexicographic order, produced one at a time by
+	// walking the shortest-path DAG. Nothing is built for a ladder until the iterator reaches it,
+	// and stepping to the next ladder only rewrites the words after the point where it differs
+	// from the last one. The range refers to the lexicon it was made from, which must outlive it.
+	class ladder_range {
+	public:
+		class iterator {
+		public:
+			using value_type = std::vector<std::string>;
+			using difference_type = std::ptrdiff_t;
+
+			iterator() = default;
+
+			[[nodiscard]] auto operator*() const noexcept -> std::vector<std::string> const& {
+				return ladder_;
+			}
+			[[nodiscard]] auto operator->() const noexcept -> std::vector<std::string> const* {
+				return &ladder_;
+			}
+			auto operator++() -> iterator&;
+			auto operator++(int) -> void {
+				++*this;
+			}
+
+			[[nodiscard]] friend auto operator==(iterator const& it, std::default_sentinel_t) noexcept
+			   -> bool {
+				return it.walk_.done();
+			}
+
+		private:
+			friend class ladder_range;
+
+			explicit iterator(ladder_range const& range);
+			// Bring ladder_ up to date with the walk
+			auto update() -> void;
+
+			ladder_range const* range_ = nullptr;
+			detail::ladder_walk walk_;
+			std::vector<std::string> ladder_;
+		};
+
+		// A range with no ladders in it
+		ladder_range() = default;
+		ladder_range(interned_lexicon const& words, detail::ladder_dag dag);
+
+		[[nodiscard]] auto begin() const -> iterator;
+		[[nodiscard]] auto end() const noexcept -> std::default_sentinel_t {
+			return {};
+		}
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return dag_.nodes.empty();
+		}
+		// How many ladders the range holds, counted over the DAG without visiting any of them.
+		// Saturates at the largest std::uint64_t.
+		[[nodiscard]] auto count() const -> std::uint64_t;
+
+		// Keeps owner alive for as long as the range, for when owner is what keeps the lexicon alive
+		auto hold(std::shared_ptr<void const> owner) -> void {
+			owner_ = std::move(owner);
+		}
+
+	private:
+		interned_lexicon const* words_ = nullptr;
+		detail::ladder_dag dag_;
+		std::shared_ptr<void const> owner_;
+	};
+} // namespace word_ladder
+
+#endif // COMP6771_LADDER_RANGE_HPP
@@ -0,0 +1,426 @@
+#ifndef COMP6771_LADDER_SEARCH_HPP
+#define COMP6771_LADDER_SEARCH_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "comp6771/alphabet.hpp"
+#include "comp6771/interned_lexicon.hpp"
+#include "comp6771/ladder_range.hpp"
+#include "comp6771/search_mode.hpp"
+#include "comp6771/search_stats.hpp"
+
+// The shortest-ladder search shared by generate and solver. It runs over any word source with
+// size(), word(id), ordered(), for_each_neighbour(id, f) and for_each_neighbour(id, f, probed),
+// such as interned_lexicon and pattern_index. Each step takes a stats policy from
+// search_stats.hpp, which defaults to recording nothing.
+namespace word_ladder::detail {
+	// An interned_lexicon whose neighbours are probed from a chosen alphabet rather than its own
+	template<alphabet_policy Alphabet>
+	class probing_lexicon {
+	public:
+		probing_lexicon(interned_lexicon const& words, Alphabet const& letters)
+		: words_(&words)
+		, letters_(letters) {}
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return words_->size();
+		}
+		[[nodiscard]] auto word(word_id id) const noexcept -> std::string_view {
+			return words_->word(id);
+		}
+		[[nodiscard]] auto ordered() const noexcept -> bool {
+			return words_->ordered();
+		}
+		template<typename F>
+		auto for_each_neighbour(word_id id, F&& f) const -> void {
+			words_->for_each_neighbour(id, letters_, f);
+		}
+		template<typename F, std::invocable Probed>
+		auto for_each_neighbour(word_id id, F&& f, Probed&& probed) const -> void {
+			words_->for_each_neighbour(id, letters_, f, probed);
+		}
+
+	private:
+		interned_lexicon const* words_;
+		Alphabet letters_;
+	};
+
+	// For each word n, the words one step closer to `from` on a shortest path through n. Every
+	// link of a search goes into one array, chained per word, so recording a link is a push_back
+	// and clearing the whole map is one clear(); once the array has grown to fit the biggest search
+	// so far, no search allocates for its links at all.
+	class parent_map {
+	public:
+		auto prepare(std::size_t words) -> void {
+			if (head_.size() < words) {
+				head_.resize(words, none);
+			}
+		}
+
+		auto add(word_id n, word_id parent) -> void {
+			links_.push_back({parent, head_[n]});
+			head_[n] = static_cast<std::uint32_t>(links_.size() - 1);
+		}
+
+		// Calls f(p) for each parent p of n, most recently added first
+		template<typename F>
+		auto for_each(word_id n, F&& f) const -> void {
+			for (auto i = head_[n]; i != none; i = links_[i].next) {
+				f(links_[i].parent);
+			}
+		}
+
+		// Forgets n's parents; clear() must follow before the links are reused
+		auto forget(word_id n) noexcept -> void {
+			head_[n] = none;
+		}
+		auto clear() noexcept -> void {
+			links_.clear();
+		}
+
+	private:
+		static constexpr auto none = std::numeric_limits<std::uint32_t>::max();
+
+		struct link {
+			word_id parent;
+			std::uint32_t next;
+		};
+
+		std::vector<std::uint32_t> head_;
+		std::vector<link> links_;
+	};
+
+	// Everything one search needs besides the words themselves. Keep one per thread and pass it to
+	// every search that thread runs: the arrays only ever grow, and each search starts by resetting
+	// just the entries the last one touched, so back-to-back queries neither reallocate nor clear
+	// whole arrays.
+	struct search_scratch {
+		// level[n] is 1 + n's distance from `from`, or -(1 + n's distance from `to`) for words seen
+		// from the `to` end of a bidirectional search, or 0 if n has not been seen
+		std::vector<int> level;
+		parent_map parents;
+		// local[n] is 1 + n's number in the last ladder_dag built, or 0 if n is not in it
+		std::vector<std::uint32_t> local;
+		std::vector<word_id> touched;
+		std::vector<word_id> front;
+		std::vector<word_id> back;
+		std::vector<word_id> next;
+		ladder_dag dag;
+		std::vector<std::uint32_t> fill;
+		ladder_walk walk;
+
+		auto prepare(std::size_t words) -> void {
+			if (level.size() < words) {
+				level.resize(words, 0);
+				parents.prepare(words);
+				local.resize(words, 0);
+			}
+		}
+
+		auto visit(word_id n, int l) -> void {
+			level[n] = l;
+			touched.push_back(n);
+		}
+
+		auto reset() -> void {
+			for (auto const n : touched) {
+				level[n] = 0;
+				parents.forget(n);
+				local[n] = 0;
+			}
+			parents.clear();
+			touched.clear();
+			front.clear();
+			back.clear();
+			next.clear();
+		}
+	};
+
+	// The scratch a thread reuses for every search it is not handed one for, so that back-to-back
+	// queries on one thread allocate nothing but their results. It keeps its storage, sized for the
+	// biggest lexicon the thread has searched, until the thread exits.
+	inline auto thread_scratch() -> search_scratch& {
+		thread_local auto scratch = search_scratch{};
+		return scratch;
+	}
+
+	// Calls f(n) for every neighbour n of id, counting the candidates tried on the way when stats
+	// are on
+	template<typename Words, typename F, typename Stats>
+	auto for_each_neighbour(Words const& words, word_id id, F&& f, Stats stats) -> void {
+		if constexpr (Stats::enabled) {
+			words.for_each_neighbour(id, f, [&stats] { stats.probe(); });
+		}
+		else {
+			words.for_each_neighbour(id, f);
+		}
+	}
+
+	// The forward_bfs pruning rule that keeps every word
+	struct keep_all {
+		constexpr auto operator()(word_id, int) const noexcept -> bool {
+			return false;
+		}
+	};
+
+	// Grow one BFS level set outward from `from` and stop at the level where `to` first appears.
+	// Only edges into the next level are kept, so parents is a DAG of shortest-path edges. A word n
+	// about to join level d is left out if prune(n, d) says it cannot be on a shortest ladder.
+	template<typename Words, typename Prune = keep_all, typename Stats = no_stats>
+	auto forward_bfs(word_id from,
+	                 word_id to,
+	                 Words const& words,
+	                 search_scratch& scratch,
+	                 Prune const& prune = {},
+	                 Stats stats = {}) -> void {
+		[[maybe_unused]] auto const timer = stats.time(&search_stats::bfs);
+		auto& level = scratch.level;
+		auto& front = scratch.front;
+		auto& next = scratch.next;
+		scratch.visit(from, 1);
+		front.push_back(from);
+
+		for (int d = 2; !front.empty() && level[to] == 0; ++d) {
+			stats.frontier(front.size());
+			next.clear();
+			for (auto const curr : front) {
+				stats.expand(static_cast<std::size_t>(d - 2));
+				for_each_neighbour(words, curr, [&](word_id n) {
+					if (level[n] == 0) {
+						if (prune(n, d)) {
+							return;
+						}
+						scratch.visit(n, d);
+						next.push_back(n);
+					}
+					// Words first seen on this level may have more than one parent
+					if (level[n] == d) {
+						scratch.parents.add(n, curr);
+						stats.parent_link();
+					}
+				}, stats);
+			}
+			std::swap(front, next);
+		}
+	}
+
+	// Grow a frontier from each end, always expanding the smaller one, and stop at the first level
+	// where they meet. Edges are recorded as from -> to parent links whichever side found them.
+	template<typename Words, typename Stats = no_stats>
+	auto bidirectional_bfs(word_id from,
+	                       word_id to,
+	                       Words const& words,
+	                       search_scratch& scratch,
+	                       Stats stats = {}) -> void {
+		[[maybe_unused]] auto const timer = stats.time(&search_stats::bfs);
+		// Only the newest level of each side can touch the other side's newest level, so any
+		// neighbour seen from the other side is on its frontier
+		auto& level = scratch.level;
+		auto& front = scratch.front;
+		auto& back = scratch.back;
+		auto& next = scratch.next;
+		scratch.visit(from, 1);
+		scratch.visit(to, -1);
+		front.push_back(from);
+		back.push_back(to);
+		auto front_side = 1; // +1 while front is the side grown from `from`, -1 otherwise
+		auto found = false;
+
+		while (!found && !front.empty() && !back.empty()) {
+			if (front.size() > back.size()) {
+				std::swap(front, back);
+				front_side = -front_side;
+			}
+
+			auto const depth = std::abs(level[front.front()]);
+			auto const next_level = front_side * (depth + 1);
+			stats.frontier(front.size());
+			next.clear();
+			for (auto const curr : front) {
+				stats.expand(static_cast<std::size_t>(depth - 1));
+				for_each_neighbour(words, curr, [&](word_id n) {
+					auto const meet = level[n] * front_side < 0;
+					if (!meet) {
+						// Once the frontiers meet, only the edges joining them are still useful
+						if (found || (level[n] != 0 && level[n] != next_level)) {
+							return;
+						}
+						if (level[n] == 0) {
+							scratch.visit(n, next_level);
+							next.push_back(n);
+						}
+					}
+					found = found || meet;
+					if (front_side > 0) {
+						scratch.parents.add(n, curr);
+					}
+					else {
+						scratch.parents.add(curr, n);
+					}
+					stats.parent_link();
+				}, stats);
+			}
+			std::swap(front, next);
+		}
+	}
+
+	// Run the BFS for one query, leaving its shortest-path edges in scratch.parents
+	template<typename Words, typename Stats = no_stats>
+	auto explore(word_id from,
+	             word_id to,
+	             Words const& words,
+	             search_mode mode,
+	             search_scratch& scratch,
+	             Stats stats = {}) -> void {
+		scratch.reset();
+		scratch.prepare(words.size());
+		if (from == to) {
+			return;
+		}
+		if (mode == search_mode::bidirectional) {
+			bidirectional_bfs(from, to, words, scratch, stats);
+		}
+		else {
+			forward_bfs(from, to, words, scratch, keep_all{}, stats);
+		}
+	}
+
+	// Turn the parent links left by explore into the forward DAG of words on a shortest ladder,
+	// reusing dag's storage. Walking back from `to` finds exactly those words (plus, after a
+	// bidirectional search, some dead ends on the `to` side that no walk from `from` ever reaches).
+	template<typename Words>
+	auto shortest_path_dag(word_id from,
+	                       word_id to,
+	                       Words const& words,
+	                       search_scratch& scratch,
+	                       ladder_dag& dag) -> void {
+		auto& nodes = dag.nodes;
+		auto& first = dag.first;
+		nodes.clear();
+		first.clear();
+		dag.children.clear();
+		dag.from = 0;
+		dag.to = 0;
+		if (from == to) {
+			nodes.push_back(from);
+			first.assign(2, 0);
+			return;
+		}
+
+		auto& local = scratch.local;
+		auto add = [&](word_id n) {
+			nodes.push_back(n);
+			local[n] = static_cast<std::uint32_t>(nodes.size());
+		};
+		// nodes doubles as the queue; first[v + 1] counts v's children for now
+		add(to);
+		for (auto i = std::size_t{0}; i < nodes.size(); ++i) {
+			scratch.parents.for_each(nodes[i], [&](word_id p) {
+				if (local[p] == 0) {
+					add(p);
+				}
+			});
+		}
+		if (local[from] == 0) {
+			// `to` may never have been reached, and so not be among the words reset() clears
+			for (auto const n : nodes) {
+				local[n] = 0;
+			}
+			nodes.clear();
+			return;
+		}
+		first.assign(nodes.size() + 1, 0);
+		for (auto const n : nodes) {
+			scratch.parents.for_each(n, [&](word_id p) { ++first[local[p]]; });
+		}
+		std::partial_sum(first.begin(), first.end(), first.begin());
+
+		auto& fill = scratch.fill;
+		fill.assign(first.begin(), first.end() - 1);
+		dag.children.resize(first.back());
+		for (auto v = std::uint32_t{0}; v < nodes.size(); ++v) {
+			scratch.parents.for_each(nodes[v], [&](word_id p) { dag.children[fill[local[p] - 1]++] = v; });
+		}
+		// Taking children in word order yields sorted ladders. Until the lexicon is updated, that is
+		// ID order, which is cheaper to compare.
+		auto sort_children = [&](auto const& before) {
+			for (auto v = std::size_t{0}; v < nodes.size(); ++v) {
+				std::sort(dag.children.begin() + first[v],
+				          dag.children.begin() + first[v + 1],
+				          [&](std::uint32_t a, std::uint32_t b) { return before(nodes[a], nodes[b]); });
+			}
+		};
+		if (words.ordered()) {
+			sort_children([](word_id a, word_id b) { return a < b; });
+		}
+		else {
+			sort_children([&words](word_id a, word_id b) { return words.word(a) < words.word(b); });
+		}
+		dag.from = local[from] - 1;
+	}
+
+	template<typename Words>
+	auto shortest_path_dag(word_id from, word_id to, Words const& words, search_scratch& scratch)
+	   -> ladder_dag {
+		auto dag = ladder_dag{};
+		shortest_path_dag(from, to, words, scratch, dag);
+		return dag;
+	}
+
+	// Every ladder in the parent links a search left in scratch, in lexicographic order
+	template<typename Words, typename Stats = no_stats>
+	auto collect(word_id from,
+	             word_id to,
+	             Words const& words,
+	             search_scratch& scratch,
+	             Stats stats = {}) -> std::vector<std::vector<std::string>> {
+		{
+			[[maybe_unused]] auto const timer = stats.time(&search_stats::dag);
+			shortest_path_dag(from, to, words, scratch, scratch.dag);
+		}
+
+		// The walk yields ladders in lexicographic order, so they go straight into the result
+		[[maybe_unused]] auto const timer = stats.time(&search_stats::enumerate);
+		auto all_paths = std::vector<std::vector<std::string>>{};
+		auto& walk = scratch.walk;
+		for (walk.start(scratch.dag); !walk.done(); walk.advance()) {
+			auto& ladder = all_paths.emplace_back();
+			ladder.reserve(walk.size());
+			for (auto i = std::size_t{0}; i < walk.size(); ++i) {
+				ladder.emplace_back(words.word(walk.word(i)));
+			}
+			stats.path();
+		}
+		return all_paths;
+	}
+
+	template<typename Words, typename Stats = no_stats>
+	auto search(word_id from,
+	            word_id to,
+	            Words const& words,
+	            search_mode mode,
+	            search_scratch& scratch,
+	            Stats stats = {}) -> std::vector<std::vector<std::string>> {
+		stats.query();
+		explore(from, to, words, mode, scratch, stats);
+		return collect(from, to, words, scratch, stats);
+	}
+
+	template<typename Words>
+	auto search(word_id from, word_id to, Words const& words, search_mode mode)
+	   -> std::vector<std::vector<std::string>> {
+		return search(from, to, words, mode, thread_scratch());
+	}
+} // namespace word_ladder::detail
+
+#endif // COMP6771_LADDER_SEARCH_HPP
@@ -0,0 +1,124 @@
+#ifndef COMP6771_LADDER_WRITER_HPP
+#define COMP6771_LADDER_WRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "comp6771/interned_lexicon.hpp"
+#include "comp6771/ladder_range.hpp"
+#include "comp6771/ladder_search.hpp"
+#include "comp6771/pattern_index.hpp"
+#include "comp6771/search_mode.hpp"
+
+namespace word_ladder {
+	// How write_ladders encodes each ladder. text is one ladder per line, its words separated by
+	// single spaces. binary is, for each ladder, its number of words and then the ID of each word
+	// in the index, all as std::uint32_t in this machine's byte order.
+	enum class ladder_format { text, binary };
+
+	// Anything write_ladders can hand bytes to
+	template<typename S>
+	concept ladder_sink = requires(S& sink, std::string_view bytes) {
+		sink.write(bytes);
+	};
+
+	// A sink over an std::ostream, which does its own buffering
+	class ostream_sink {
+	public:
+		explicit ostream_sink(std::ostream& out) noexcept
+		: out_(&out) {}
+
+		auto write(std::string_view bytes) -> void;
+
+	private:
+		std::ostream* out_;
+	};
+
+	// A sink over a file descriptor, such as STDOUT_FILENO or a file opened for writing. Bytes
+	// gather in a fixed-size buffer that goes out in one write() each time it fills, on flush(),
+	// and on destruction. The descriptor is left open. Throws std::runtime_error if a write fails;
+	// call flush() before the sink is destroyed to hear about a failure in the last one.
+	class fd_sink {
+	public:
+		explicit fd_sink(int fd, std::size_t buffer_size = std::size_t{1} << 16);
+		fd_sink(fd_sink const&) = delete;
+		auto operator=(fd_sink const&) -> fd_sink& = delete;
+		~fd_sink();
+
+		auto write(std::string_view bytes) -> void;
+		auto flush() -> void;
+
+	private:
+		int fd_;
+		std::vector<char> buffer_;
+		std::size_t used_ = 0;
+	};
+
+	namespace detail {
+		// Writes every path in dag to sink as walk reaches it. Only the current ladder is ever held:
+		// in text, the line is rewritten from the first word that changed since the last ladder.
+		template<typename Words, ladder_sink Sink>
+		auto write_dag(Words const& words,
+		               ladder_dag const& dag,
+		               ladder_walk& walk,
+		               Sink& sink,
+		               ladder_format format) -> std::uint64_t {
+			auto written = std::uint64_t{0};
+			auto line = std::string{};
+			// ends[i] is where word i and the character after it end in line
+			auto ends = std::vector<std::size_t>{};
+			auto ids = std::vector<std::uint32_t>{};
+			for (walk.start(dag); !walk.done(); walk.advance()) {
+				if (format == ladder_format::text) {
+					auto const keep = walk.changed();
+					line.resize(keep == 0 ? 0 : ends[keep - 1]);
+					ends.resize(keep);
+					for (auto i = keep; i < walk.size(); ++i) {
+						line.append(words.word(walk.word(i)));
+						line.push_back(i + 1 < walk.size() ? ' ' : '\n');
+						ends.push_back(line.size());
+					}
+					sink.write(line);
+				}
+				else {
+					ids.resize(walk.size() + 1);
+					ids[0] = static_cast<std::uint32_t>(walk.size());
+					for (auto i = std::size_t{0}; i < walk.size(); ++i) {
+						ids[i + 1] = walk.word(i);
+					}
+					sink.write(std::string_view(reinterpret_cast<char const*>(ids.data()),
+					                            ids.size() * sizeof(std::uint32_t)));
+				}
+				++written;
+			}
+			return written;
+		}
+	} // namespace detail
+
+	// Writes the ladders generate over index would return to sink, in the same order, as they are
+	// enumerated. However many ladders there are, no more than one is held in memory at a time.
+	// Returns how many were written.
+	template<ladder_sink Sink>
+	auto write_ladders(std::string const& from,
+	                   std::string const& to,
+	                   pattern_index const& index,
+	                   Sink& sink,
+	                   ladder_format format = ladder_format::text,
+	                   search_mode mode = search_mode::bidirectional) -> std::uint64_t {
+		auto const from_id = index.find(from);
+		auto const to_id = index.find(to);
+		if (!from_id || !to_id || !index.connected(*from_id, *to_id)) {
+			return 0;
+		}
+		auto& scratch = detail::thread_scratch();
+		detail::explore(*from_id, *to_id, index, mode, scratch);
+		detail::shortest_path_dag(*from_id, *to_id, index, scratch, scratch.dag);
+		return detail::write_dag(index, scratch.dag, scratch.walk, sink, format);
+	}
+} // namespace word_ladder
+
+#endif // COMP6771_LADDER_WRITER_HPP
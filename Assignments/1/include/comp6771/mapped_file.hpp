@@ -0,0 +1,41 @@
+#ifndef COMP6771_MAPPED_FILE_HPP
+#define COMP6771_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace word_ladder {
+	// A whole file mapped read-only into memory for as long as the object lives. Files that cannot
+	// be mapped, such as pipes, terminals and those under /proc, are read into memory instead. The
+	// contents do not move when the object does, so views into them survive moves too.
+	class mapped_file {
+	public:
+		explicit mapped_file(std::string const& path);
+		mapped_file(mapped_file const&) = delete;
+		mapped_file(mapped_file&& other) noexcept;
+		auto operator=(mapped_file const&) -> mapped_file& = delete;
+		auto operator=(mapped_file&& other) noexcept -> mapped_file&;
+		~mapped_file();
+
+		[[nodiscard]] auto data() const noexcept -> char const* {
+			return data_ != nullptr ? static_cast<char const*>(data_) : contents_.data();
+		}
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return size_;
+		}
+		[[nodiscard]] auto text() const noexcept -> std::string_view {
+			return {data(), size_};
+		}
+
+	private:
+		// The mapping, if there is one
+		void* data_ = nullptr;
+		std::size_t size_ = 0;
+		// What was read, for a file that could not be mapped
+		std::vector<char> contents_;
+	};
+} // namespace word_ladder
+
+#endif // COMP6771_MAPPED_FILE_HPP
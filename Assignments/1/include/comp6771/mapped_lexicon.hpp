@@ -0,0 +1,32 @@
+#ifndef COMP6771_MAPPED_LEXICON_HPP
+#define COMP6771_MAPPED_LEXICON_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "comp6771/mapped_file.hpp"
+
+namespace word_ladder {
+	// A whitespace-separated word list mapped straight into memory. The words are views into the
+	// mapping, so nothing is copied or allocated per word; they stay valid for the object's life.
+	// A word that appears more than once in the file appears more than once in words().
+	class mapped_lexicon {
+	public:
+		explicit mapped_lexicon(std::string const& path);
+
+		[[nodiscard]] auto words() const noexcept -> std::vector<std::string_view> const& {
+			return words_;
+		}
+
+		// The same set read_lexicon returns for this file
+		[[nodiscard]] auto to_set() const -> absl::flat_hash_set<std::string>;
+
+	private:
+		mapped_file file_;
+		std::vector<std::string_view> words_;
+	};
+} // namespace word_ladder
+
+#endif // COMP6771_MAPPED_LEXICON_HPP
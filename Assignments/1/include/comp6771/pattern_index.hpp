@@ -0,0 +1,163 @@
+#ifndef COMP6771_PATTERN_INDEX_HPP
+#define COMP6771_PATTERN_INDEX_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "comp6771/flat_array.hpp"
+#include "comp6771/interned_lexicon.hpp"
+
+namespace word_ladder {
+	// Wildcard-pattern adjacency index over the words of one length in a lexicon, numbered as in
+	// interned_lexicon. For every position, the words that agree everywhere else (i.e. match the
+	// same pattern, such as c*t) form one bucket of word IDs, so finding the neighbours of a word is
+	// one bucket scan per position rather than 26 hash probes. Build it once and share it between
+	// as many queries as you like; insert and erase update it in place, so they must not run while
+	// anything else is reading it.
+	class pattern_index {
+	public:
+		// The [first, last) range of members() holding one group of words sharing a pattern
+		struct slice {
+			std::uint32_t first;
+			std::uint32_t last;
+		};
+
+		pattern_index(absl::flat_hash_set<std::string> const& lexicon, std::size_t length);
+		explicit pattern_index(interned_lexicon words);
+		// Reassembles an index from the parts another one exposes through members(), buckets(),
+		// components() and component_sizes()
+		pattern_index(interned_lexicon words,
+		              flat_array<word_id> members,
+		              flat_array<slice> buckets,
+		              flat_array<std::uint32_t> components,
+		              flat_array<std::uint32_t> component_sizes);
+
+		// Adds word and returns its ID, as interned_lexicon::insert does. The word joins the group
+		// it belongs to at each position, and the components of those groups are merged into the
+		// biggest of them; no other group or component is touched.
+		// Pre: word has length() characters and is not in the index
+		auto insert(std::string_view word) -> word_id;
+		// Removes the word `id`, as interned_lexicon::erase does, taking it out of its groups. Only
+		// its own component is checked again, in case the word was the only link between its parts.
+		// Pre: words().contains(id)
+		auto erase(word_id id) -> void;
+
+		// The index a fresh build over the same words gives, and whether this one already is it: true
+		// until the first insert or erase
+		[[nodiscard]] auto compacted() const -> pattern_index;
+		[[nodiscard]] auto compact() const noexcept -> bool {
+			return compact_;
+		}
+
+		[[nodiscard]] auto words() const noexcept -> interned_lexicon const& {
+			return words_;
+		}
+		[[nodiscard]] auto length() const noexcept -> std::size_t {
+			return words_.length();
+		}
+		// As in interned_lexicon: one past the largest ID, and how many words there are
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return words_.size();
+		}
+		[[nodiscard]] auto word_count() const noexcept -> std::size_t {
+			return words_.word_count();
+		}
+		[[nodiscard]] auto ordered() const noexcept -> bool {
+			return words_.ordered();
+		}
+		[[nodiscard]] auto word(word_id id) const noexcept -> std::string_view {
+			return words_.word(id);
+		}
+		[[nodiscard]] auto find(std::string_view word) const -> std::optional<word_id> {
+			return words_.find(word);
+		}
+
+		[[nodiscard]] auto members() const noexcept -> std::span<word_id const> {
+			return members_.span();
+		}
+		[[nodiscard]] auto buckets() const noexcept -> std::span<slice const> {
+			return buckets_.span();
+		}
+
+		// Words are split into connected components; two words have a ladder between them exactly
+		// when they share a component. components()[id] is id's component and component_sizes()[c]
+		// is how many words c has. A fresh build numbers them 0, 1, 2, ... in order of their smallest
+		// ID. Updates keep the numbers of the components they leave alone, and a number whose
+		// component has gone is unused, with size 0, until an update needs a new one.
+		// components()[id] means nothing for an erased id.
+		[[nodiscard]] auto components() const noexcept -> std::span<std::uint32_t const> {
+			return components_.span();
+		}
+		[[nodiscard]] auto component_sizes() const noexcept -> std::span<std::uint32_t const> {
+			return component_sizes_.span();
+		}
+		[[nodiscard]] auto component(word_id id) const noexcept -> std::uint32_t {
+			return components_[id];
+		}
+		[[nodiscard]] auto connected(word_id a, word_id b) const noexcept -> bool {
+			return components_[a] == components_[b];
+		}
+
+		// IDs of every word matching `pattern`, which has exactly one '*' in it
+		[[nodiscard]] auto matches(std::string_view pattern) const -> std::span<word_id const>;
+
+		// Calls f(n) for every word n that differs from `id` in exactly one position
+		template<typename F>
+		auto for_each_neighbour(word_id id, F&& f) const -> void {
+			for_each_neighbour(id, f, [] {});
+		}
+
+		// As above, calling probed() for each bucket entry read
+		template<typename F, std::invocable Probed>
+		auto for_each_neighbour(word_id id, F&& f, Probed&& probed) const -> void {
+			for (auto p = std::size_t{0}; p < length(); ++p) {
+				auto const [first, last] = buckets_[std::size_t{id} * length() + p];
+				for (auto const n : members().subspan(first, last - first)) {
+					probed();
+					if (n != id) {
+						f(n);
+					}
+				}
+			}
+		}
+
+	private:
+		// The slice of members_ holding id's group at position p
+		[[nodiscard]] auto group_of(word_id id, std::size_t p) const noexcept
+		   -> std::span<word_id const> {
+			auto const [first, last] = buckets_[std::size_t{id} * length() + p];
+			return members().subspan(first, last - first);
+		}
+		// An ID from the group word would join at position p, if that group has anyone in it
+		[[nodiscard]] auto group_member(std::string_view word, std::size_t p) const
+		   -> std::optional<word_id>;
+		// Moves every group to the front of members_, in the order of their first members' IDs
+		auto collect_garbage() -> void;
+		auto join_components(word_id id) -> void;
+		auto split_component(word_id id, std::span<word_id const> neighbours) -> void;
+		auto new_component(std::uint32_t size) -> std::uint32_t;
+
+		interned_lexicon words_;
+		// Each group of words sharing a pattern is a slice of members_, and buckets_[id * length() +
+		// p] is the [first, last) slice holding id's group at position p. A fresh build lays the
+		// groups out position by position; an update that grows a group moves it to the end, and
+		// the slice it leaves behind is garbage until collect_garbage() packs members_ again.
+		flat_array<word_id> members_;
+		flat_array<slice> buckets_;
+		flat_array<std::uint32_t> components_;
+		flat_array<std::uint32_t> component_sizes_;
+		std::size_t garbage_ = 0;
+		// Component numbers with size 0, for updates to reuse
+		std::vector<std::uint32_t> free_components_;
+		bool compact_ = true;
+	};
+} // namespace word_ladder
+
+#endif // COMP6771_PATTERN_INDEX_HPP
@@ -0,0 +1,47 @@
+#ifndef COMP6771_PERFECT_HASH_HPP
+#define COMP6771_PERFECT_HASH_HPP
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string_view>
+
+#include "comp6771/flat_array.hpp"
+
+namespace word_ladder {
+	// A collision-free hash from a fixed set of keys to their positions in that set, built with the
+	// hash-and-displace scheme: keys are first spread over small buckets, then each bucket gets a
+	// seed that sends all of its keys to distinct free slots. A lookup is one hash and two array
+	// reads. Keys outside the set still land on some slot, so callers compare the key they get back.
+	// The hash only depends on the key bytes and the stored salt, so the tables can be saved to a
+	// file and used by another process on the same kind of machine.
+	class perfect_hash {
+	public:
+		static constexpr auto absent = std::numeric_limits<std::uint32_t>::max();
+
+		perfect_hash() = default;
+		// Pre: keys has no repeats
+		explicit perfect_hash(std::span<std::string_view const> keys);
+		perfect_hash(std::uint64_t salt, flat_array<std::uint32_t> seeds, flat_array<std::uint32_t> slots);
+
+		// The position key would have if it is one of the keys, else absent or some other position
+		[[nodiscard]] auto lookup(std::string_view key) const noexcept -> std::uint32_t;
+
+		[[nodiscard]] auto salt() const noexcept -> std::uint64_t {
+			return salt_;
+		}
+		[[nodiscard]] auto seeds() const noexcept -> std::span<std::uint32_t const> {
+			return seeds_.span();
+		}
+		[[nodiscard]] auto slots() const noexcept -> std::span<std::uint32_t const> {
+			return slots_.span();
+		}
+
+	private:
+		std::uint64_t salt_ = 0;
+		flat_array<std::uint32_t> seeds_;
+		flat_array<std::uint32_t> slots_;
+	};
+} // namespace word_ladder
+
+#endif // COMP6771_PERFECT_HASH_HPP
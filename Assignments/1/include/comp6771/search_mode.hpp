@@ -0,0 +1,11 @@
+#ifndef COMP6771_SEARCH_MODE_HPP
+#define COMP6771_SEARCH_MODE_HPP
+
+namespace word_ladder {
+	// How generate explores the word graph. forward grows a single BFS from the start word;
+	// bidirectional grows one from each end, always expanding the smaller frontier, and stops at
+	// the first level where the two meet.
+	enum class search_mode { forward, bidirectional };
+} // namespace word_ladder
+
+#endif // COMP6771_SEARCH_MODE_HPP
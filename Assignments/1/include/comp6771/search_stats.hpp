@@ -0,0 +1,132 @@
+#ifndef COMP6771_SEARCH_STATS_HPP
+#define COMP6771_SEARCH_STATS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace word_ladder {
+	// Where the work in one or more searches went. Pass one to a search to have it filled in, and
+	// add several together with += to total up a batch. Searches add to what is already there.
+	struct search_stats {
+		std::uint64_t queries = 0;
+		// Candidate neighbours looked at: hash lookups when probing a lexicon letter by letter, or
+		// bucket entries read when walking a pattern_index
+		std::uint64_t probes = 0;
+		// expanded[d] is the number of words expanded d steps from the end they were reached from
+		std::vector<std::uint64_t> expanded;
+		// The most words waiting on any one frontier
+		std::uint64_t peak_frontier = 0;
+		// The size of the parent map: shortest-path edges recorded by the BFS
+		std::uint64_t parent_links = 0;
+		std::uint64_t paths = 0;
+
+		// Time spent finding the two words, in the BFS, building the shortest-path DAG from the
+		// parent map, and enumerating the ladders out of it
+		std::chrono::nanoseconds lookup{};
+		std::chrono::nanoseconds bfs{};
+		std::chrono::nanoseconds dag{};
+		std::chrono::nanoseconds enumerate{};
+
+		auto operator+=(search_stats const& other) -> search_stats& {
+			queries += other.queries;
+			probes += other.probes;
+			if (expanded.size() < other.expanded.size()) {
+				expanded.resize(other.expanded.size(), 0);
+			}
+			for (auto d = std::size_t{0}; d < other.expanded.size(); ++d) {
+				expanded[d] += other.expanded[d];
+			}
+			peak_frontier = std::max(peak_frontier, other.peak_frontier);
+			parent_links += other.parent_links;
+			paths += other.paths;
+			lookup += other.lookup;
+			bfs += other.bfs;
+			dag += other.dag;
+			enumerate += other.enumerate;
+			return *this;
+		}
+	};
+
+	namespace detail {
+		// Stats policies for the search. Each is passed by value and has the same hooks; no_stats
+		// does nothing in any of them, so a search run with it compiles to the same code as one
+		// with no hooks at all.
+		struct no_stats {
+			static constexpr auto enabled = false;
+
+			// Does nothing on either end of a phase
+			struct timer {};
+
+			constexpr auto query() const noexcept -> void {}
+			constexpr auto probe() const noexcept -> void {}
+			constexpr auto expand(std::size_t) const noexcept -> void {}
+			constexpr auto frontier(std::size_t) const noexcept -> void {}
+			constexpr auto parent_link() const noexcept -> void {}
+			constexpr auto path() const noexcept -> void {}
+			constexpr auto time(std::chrono::nanoseconds search_stats::*) const noexcept -> timer {
+				return {};
+			}
+		};
+
+		// Records into a search_stats, which must outlive it
+		class record_stats {
+		public:
+			static constexpr auto enabled = true;
+
+			// Adds the time from its construction to its destruction to one phase
+			class timer {
+			public:
+				explicit timer(std::chrono::nanoseconds& phase) noexcept
+				: phase_(&phase)
+				, start_(std::chrono::steady_clock::now()) {}
+				timer(timer const&) = delete;
+				auto operator=(timer const&) -> timer& = delete;
+				~timer() {
+					*phase_ += std::chrono::steady_clock::now() - start_;
+				}
+
+			private:
+				std::chrono::nanoseconds* phase_;
+				std::chrono::steady_clock::time_point start_;
+			};
+
+			explicit record_stats(search_stats& stats) noexcept
+			: stats_(&stats) {}
+
+			auto query() const noexcept -> void {
+				++stats_->queries;
+			}
+			auto probe() const noexcept -> void {
+				++stats_->probes;
+			}
+			auto expand(std::size_t depth) const -> void {
+				auto& expanded = stats_->expanded;
+				if (expanded.size() <= depth) {
+					expanded.resize(depth + 1, 0);
+				}
+				++expanded[depth];
+			}
+			auto frontier(std::size_t size) const noexcept -> void {
+				stats_->peak_frontier = std::max(stats_->peak_frontier, std::uint64_t{size});
+			}
+			auto parent_link() const noexcept -> void {
+				++stats_->parent_links;
+			}
+			auto path() const noexcept -> void {
+				++stats_->paths;
+			}
+			[[nodiscard]] auto time(std::chrono::nanoseconds search_stats::*phase) const noexcept
+			   -> timer {
+				return timer(stats_->*phase);
+			}
+
+		private:
+			search_stats* stats_;
+		};
+	} // namespace detail
+} // namespace word_ladder
+
+#endif // COMP6771_SEARCH_STATS_HPP
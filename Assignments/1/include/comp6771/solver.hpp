@@ -0,0 +1,151 @@
+#ifndef COMP6771_SOLVER_HPP
+#define COMP6771_SOLVER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "comp6771/ladder_range.hpp"
+#include "comp6771/ladder_writer.hpp"
+#include "comp6771/pattern_index.hpp"
+#include "comp6771/search_stats.hpp"
+#include "comp6771/work_stealing_pool.hpp"
+#include "comp6771/word_ladder.hpp"
+
+namespace word_ladder {
+	// Answers many ladder queries against one lexicon. The lexicon is split by word length and each
+	// partition is interned and pattern-indexed once, up front, so a query pays only for its search.
+	// save() writes those indexes to a file that open() maps straight back in, so a later process
+	// can start answering queries without reading or hashing a single word.
+	//
+	// The lexicon can change while queries run: insert and erase publish a new snapshot of the
+	// indexes, updating only the partition they touch, and every query (or batch of queries) works
+	// on the snapshot that was current when it started.
+	class solver {
+	public:
+		explicit solver(absl::flat_hash_set<std::string> const& lexicon);
+		// Builds straight from a word list such as mapped_lexicon::words(); repeats are ignored
+		explicit solver(std::span<std::string_view const> words);
+
+		// Adds a word to the lexicon, or returns false if it is empty or already there. Safe to call
+		// while other threads run queries; updates wait for each other.
+		auto insert(std::string_view word) -> bool;
+		// Removes a word from the lexicon, or returns false if it is not there. Thread safety as above.
+		auto erase(std::string_view word) -> bool;
+
+		// Writes every partition's words, perfect hash and pattern index to path, as a fresh build
+		// over the current lexicon would have them. The file uses this machine's byte order, so it
+		// should be read back on the same kind of machine.
+		auto save(std::string const& path) const -> void;
+		// A solver over a file written by save(). Nothing is copied: the indexes point into the
+		// mapped file. Throws std::runtime_error if the file cannot be opened or is not such a file.
+		[[nodiscard]] static auto open(std::string const& path) -> solver;
+
+		// Same result as word_ladder::generate over the lexicon the solver was built from
+		[[nodiscard]] auto generate(std::string const& from,
+		                            std::string const& to,
+		                            search_mode mode = search_mode::bidirectional) const
+		   -> std::vector<std::vector<std::string>>;
+		// As above, adding what the search cost to stats
+		[[nodiscard]] auto generate(std::string const& from,
+		                            std::string const& to,
+		                            search_mode mode,
+		                            search_stats& stats) const -> std::vector<std::vector<std::string>>;
+		// The same ladders as generate, produced lazily; see word_ladder::ladders
+		[[nodiscard]] auto ladders(std::string const& from,
+		                           std::string const& to,
+		                           search_mode mode = search_mode::bidirectional) const -> ladder_range;
+		// See word_ladder::count_ladders and word_ladder::first_k_ladders
+		[[nodiscard]] auto count_ladders(std::string const& from,
+		                                 std::string const& to,
+		                                 search_mode mode = search_mode::bidirectional) const
+		   -> std::uint64_t;
+		[[nodiscard]] auto first_k_ladders(std::string const& from,
+		                                   std::string const& to,
+		                                   std::size_t k,
+		                                   search_mode mode = search_mode::bidirectional) const
+		   -> std::vector<std::vector<std::string>>;
+
+		// See word_ladder::write_ladders
+		template<ladder_sink Sink>
+		auto write_ladders(std::string const& from,
+		                   std::string const& to,
+		                   Sink& sink,
+		                   ladder_format format = ladder_format::text,
+		                   search_mode mode = search_mode::bidirectional) const -> std::uint64_t {
+			auto const words = index(from.size());
+			if (words == nullptr) {
+				return 0;
+			}
+			return word_ladder::write_ladders(from, to, *words, sink, format, mode);
+		}
+
+		// One generate result per query, in the same order as the queries. The queries are spread
+		// over every core, on threads the solver starts for its first batch and keeps for the rest;
+		// pass a pool to share its threads with other work or to use fewer cores.
+		[[nodiscard]] auto generate_many(std::span<std::pair<std::string, std::string> const> queries,
+		                                 search_mode mode = search_mode::bidirectional) const
+		   -> std::vector<std::vector<std::vector<std::string>>>;
+		[[nodiscard]] auto generate_many(std::span<std::pair<std::string, std::string> const> queries,
+		                                 work_stealing_pool& pool,
+		                                 search_mode mode = search_mode::bidirectional) const
+		   -> std::vector<std::vector<std::vector<std::string>>>;
+		// As above, adding what the whole batch cost to stats
+		[[nodiscard]] auto generate_many(std::span<std::pair<std::string, std::string> const> queries,
+		                                 work_stealing_pool& pool,
+		                                 search_mode mode,
+		                                 search_stats& stats) const
+		   -> std::vector<std::vector<std::vector<std::string>>>;
+
+		// The current index over words of the given length, or nullptr if the lexicon has none. It
+		// stays valid, and unchanged, however the lexicon changes afterwards.
+		[[nodiscard]] auto index(std::size_t length) const -> std::shared_ptr<pattern_index const>;
+
+	private:
+		// Every partition's index, by word length. A snapshot is never changed once published;
+		// updates copy the map and replace the one partition they change, sharing the rest.
+		using snapshot = absl::flat_hash_map<std::size_t, std::shared_ptr<pattern_index const>>;
+
+		// A word to insert into, or erase from, a partition
+		struct update {
+			bool insert;
+			std::string word;
+		};
+
+		// Each partition has two copies of its index that updates take turns with. `live` is the one
+		// in the current snapshot. `spare` is the one it replaced, and is behind by one update,
+		// `missed`; once no query holds it any more, the next update catches it up and applies
+		// itself to it in place, and it becomes `live`.
+		struct partition {
+			std::shared_ptr<pattern_index> live;
+			std::shared_ptr<pattern_index> spare;
+			update missed;
+		};
+
+		explicit solver(absl::flat_hash_map<std::size_t, std::shared_ptr<pattern_index>> indexes);
+
+		// Applies u to the partition and publishes the result
+		auto apply(std::size_t length, partition& words, update u) -> void;
+		// Publishes a snapshot with `words` as the index of that length, or none if it is nullptr
+		auto publish(std::size_t length, std::shared_ptr<pattern_index const> words) -> void;
+
+		std::atomic<std::shared_ptr<snapshot const>> indexes_;
+		// The pool generate_many uses when it is not given one
+		mutable std::once_flag pool_started_;
+		mutable std::unique_ptr<work_stealing_pool> pool_;
+		// Guarded by update_
+		absl::flat_hash_map<std::size_t, partition> partitions_;
+		std::mutex update_;
+	};
+} // namespace word_ladder
+
+#endif // COMP6771_SOLVER_HPP
@@ -4,10 +4,20 @@
 #ifndef COMP6771_WORD_LADDER_HPP
 #define COMP6771_WORD_LADDER_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
 #include "absl/container/flat_hash_set.h"
+#include "comp6771/alphabet.hpp"
+#include "comp6771/distance_oracle.hpp"
+#include "comp6771/interned_lexicon.hpp"
+#include "comp6771/ladder_range.hpp"
+#include "comp6771/ladder_search.hpp"
+#include "comp6771/pattern_index.hpp"
+#include "comp6771/search_mode.hpp"
+#include "comp6771/search_stats.hpp"
 
 namespace word_ladder {
 	[[nodiscard]] auto read_lexicon(std::string const& path) -> absl::flat_hash_set<std::string>;
@@ -16,9 +26,72 @@ namespace word_ladder {
 	// start word to the destination, where each word in an individual path is a valid word per the
 	// provided lexicon. Pre: ranges::size(from) == ranges::size(to) Pre: valid_words.contains(from)
 	// and valid_words.contains(to)
+	// Neighbours are found by trying, at each position, every character the lexicon's words of that
+	// length are made of, so digits, capitals and non-ASCII bytes all work.
 	[[nodiscard]] auto generate(std::string const& from,
 	                            std::string const& to,
-	                            absl::flat_hash_set<std::string> const& lexicon)
+	                            absl::flat_hash_set<std::string> const& lexicon,
+	                            search_mode mode = search_mode::bidirectional)
+	   -> std::vector<std::vector<std::string>>;
+
+	// As above, but only ever tries the letters of `letters`, such as lowercase{}. A compile-time
+	// alphabet is tried with a fully unrolled loop. Words with characters outside it are still
+	// found, but never reached by changing a letter to one of those characters.
+	template<alphabet_policy Alphabet>
+	[[nodiscard]] auto generate(std::string const& from,
+	                            std::string const& to,
+	                            absl::flat_hash_set<std::string> const& lexicon,
+	                            Alphabet const& letters,
+	                            search_mode mode = search_mode::bidirectional)
+	   -> std::vector<std::vector<std::string>> {
+		auto const words = interned_lexicon(lexicon, from.size());
+		auto const from_id = words.find(from);
+		auto const to_id = words.find(to);
+		if (!from_id || !to_id) {
+			return {};
+		}
+		return detail::search(*from_id, *to_id, detail::probing_lexicon(words, letters), mode);
+	}
+
+	// As above, but finds neighbours through a prebuilt index over words of the same length as from.
+	// Returns no ladders if either word is missing from the index.
+	[[nodiscard]] auto generate(std::string const& from,
+	                            std::string const& to,
+	                            pattern_index const& index,
+	                            search_mode mode = search_mode::bidirectional)
+	   -> std::vector<std::vector<std::string>>;
+	// As above, adding what the search cost to stats
+	[[nodiscard]] auto generate(std::string const& from,
+	                            std::string const& to,
+	                            pattern_index const& index,
+	                            search_mode mode,
+	                            search_stats& stats) -> std::vector<std::vector<std::string>>;
+
+	// As generate over oracle.index(), but asks the oracle how long the ladders are first and then
+	// never visits a word whose lower bound to `to` rules it out, A*-style. Only searches forward.
+	[[nodiscard]] auto generate(std::string const& from,
+	                            std::string const& to,
+	                            distance_oracle const& oracle) -> std::vector<std::vector<std::string>>;
+
+	// The same ladders as generate over index, produced lazily in the same order. Stop iterating
+	// early to pay only for the ladders you look at. The range refers to index.
+	[[nodiscard]] auto ladders(std::string const& from,
+	                           std::string const& to,
+	                           pattern_index const& index,
+	                           search_mode mode = search_mode::bidirectional) -> ladder_range;
+
+	// How many ladders generate would return, without building any of them
+	[[nodiscard]] auto count_ladders(std::string const& from,
+	                                 std::string const& to,
+	                                 pattern_index const& index,
+	                                 search_mode mode = search_mode::bidirectional) -> std::uint64_t;
+
+	// The first k ladders generate would return, without building the rest
+	[[nodiscard]] auto first_k_ladders(std::string const& from,
+	                                   std::string const& to,
+	                                   pattern_index const& index,
+	                                   std::size_t k,
+	                                   search_mode mode = search_mode::bidirectional)
 	   -> std::vector<std::vector<std::string>>;
 } // namespace word_ladder
 
@@ -0,0 +1,66 @@
+#ifndef COMP6771_WORK_STEALING_POOL_HPP
+#define COMP6771_WORK_STEALING_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace word_ladder {
+	// A fixed set of worker threads for running independent, index-addressed jobs. Each worker
+	// starts with an even share of the indices and, once its own share runs dry, steals half of
+	// whatever another worker has left, so a few slow jobs cannot leave the other cores idle.
+	class work_stealing_pool {
+	public:
+		// The calling thread of parallel_for counts as one of the workers
+		explicit work_stealing_pool(std::size_t workers = std::thread::hardware_concurrency());
+		work_stealing_pool(work_stealing_pool const&) = delete;
+		work_stealing_pool(work_stealing_pool&&) = delete;
+		auto operator=(work_stealing_pool const&) -> work_stealing_pool& = delete;
+		auto operator=(work_stealing_pool&&) -> work_stealing_pool& = delete;
+		~work_stealing_pool();
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return queues_.size();
+		}
+
+		// Calls body(i, worker) once for every i in [0, count) and returns when all calls have.
+		// worker is in [0, size()) and no two concurrent calls share one, so it can index
+		// per-worker scratch state. If any call throws, the first exception is rethrown here.
+		// Calls from different threads take turns.
+		auto parallel_for(std::size_t count,
+		                  std::function<void(std::size_t, std::size_t)> const& body) -> void;
+
+	private:
+		struct queue {
+			std::mutex mutex;
+			std::size_t first = 0;
+			std::size_t last = 0;
+		};
+
+		auto run(std::size_t worker) -> void;
+		auto next(std::size_t worker) -> std::optional<std::size_t>;
+		auto work(std::stop_token stop, std::size_t worker) -> void;
+
+		std::mutex job_;
+		std::vector<std::unique_ptr<queue>> queues_;
+		std::function<void(std::size_t, std::size_t)> const* body_ = nullptr;
+		std::exception_ptr error_;
+
+		std::mutex mutex_;
+		std::condition_variable_any start_;
+		std::condition_variable finish_;
+		std::size_t generation_ = 0;
+		std::size_t running_ = 0;
+		// Declared last so the threads stop before anything they use is destroyed
+		std::vector<std::jthread> threads_;
+	};
+} // namespace word_ladder
+
+#endif // COMP6771_WORK_STEALING_POOL_HPP
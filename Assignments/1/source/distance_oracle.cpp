@@ -0,0 +1,183 @@
+#include "comp6771/distance_oracle.hpp"
+#include <absl/container/flat_hash_map.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace word_ladder {
+	namespace {
+		// Every word's distance from source, or distance_oracle::unreachable
+		auto distances_from(pattern_index const& index, word_id source) -> std::vector<std::uint32_t> {
+			auto distance = std::vector<std::uint32_t>(index.size(), distance_oracle::unreachable);
+			auto front = std::vector<word_id>{source};
+			auto next = std::vector<word_id>{};
+			distance[source] = 0;
+			for (auto d = std::uint32_t{1}; !front.empty(); ++d) {
+				next.clear();
+				for (auto const curr : front) {
+					index.for_each_neighbour(curr, [&](word_id n) {
+						if (distance[n] == distance_oracle::unreachable) {
+							distance[n] = d;
+							next.push_back(n);
+						}
+					});
+				}
+				std::swap(front, next);
+			}
+			return distance;
+		}
+
+		auto degree(pattern_index const& index, word_id id) -> std::size_t {
+			auto neighbours = std::size_t{0};
+			index.for_each_neighbour(id, [&neighbours](word_id) { ++neighbours; });
+			return neighbours;
+		}
+	} // namespace
+
+	distance_oracle::distance_oracle(pattern_index const& index, std::size_t landmarks)
+	: index_(&index) {
+		auto const n = index.size();
+		landmarks = std::min(landmarks, n);
+		// Pick each landmark as far as possible from those already picked, so they spread over the
+		// graph; words no landmark reaches count as infinitely far, so every sizeable component
+		// gets one. Ties go to the best-connected word, and isolated words are never picked.
+		auto nearest = std::vector<std::uint32_t>(n, unreachable);
+		auto degrees = std::vector<std::size_t>(n);
+		for (auto id = word_id{0}; id < n; ++id) {
+			degrees[id] = degree(index, id);
+		}
+		auto columns = std::vector<std::vector<std::uint32_t>>{};
+		while (landmarks_.size() < landmarks) {
+			auto best = std::optional<word_id>();
+			for (auto id = word_id{0}; id < n; ++id) {
+				if (degrees[id] != 0
+				    and (!best
+				         or std::pair(nearest[id], degrees[id]) > std::pair(nearest[*best], degrees[*best])))
+				{
+					best = id;
+				}
+			}
+			if (!best or nearest[*best] == 0) {
+				break; // Every word with a neighbour is already a landmark
+			}
+			landmarks_.push_back(*best);
+			auto& column = columns.emplace_back(distances_from(index, *best));
+			for (auto id = word_id{0}; id < n; ++id) {
+				nearest[id] = std::min(nearest[id], column[id]);
+			}
+		}
+
+		distances_.resize(n * landmarks_.size());
+		for (auto l = std::size_t{0}; l < columns.size(); ++l) {
+			for (auto id = std::size_t{0}; id < n; ++id) {
+				distances_[id * landmarks_.size() + l] = columns[l][id];
+			}
+		}
+	}
+
+	auto distance_oracle::lower_bound(word_id a, word_id b) const noexcept -> std::uint32_t {
+		if (a == b) {
+			return 0;
+		}
+		if (!index_->connected(a, b)) {
+			return unreachable;
+		}
+		auto bound = std::uint32_t{1};
+		auto const to_a = row(a);
+		auto const to_b = row(b);
+		for (auto l = std::size_t{0}; l < to_a.size(); ++l) {
+			if (to_a[l] != unreachable) {
+				bound = std::max(bound, to_a[l] > to_b[l] ? to_a[l] - to_b[l] : to_b[l] - to_a[l]);
+			}
+		}
+		return bound;
+	}
+
+	auto distance_oracle::upper_bound(word_id a, word_id b) const noexcept -> std::uint32_t {
+		if (a == b) {
+			return 0;
+		}
+		auto bound = unreachable;
+		auto const to_a = row(a);
+		auto const to_b = row(b);
+		for (auto l = std::size_t{0}; l < to_a.size(); ++l) {
+			if (to_a[l] != unreachable and to_b[l] != unreachable) {
+				bound = std::min(bound, to_a[l] + to_b[l]);
+			}
+		}
+		return bound;
+	}
+
+	auto distance_oracle::distance(word_id a, word_id b) const -> std::uint32_t {
+		auto const lower = lower_bound(a, b);
+		auto const upper = upper_bound(a, b);
+		if (lower == upper or lower == unreachable) {
+			return lower;
+		}
+
+		// Look for a ladder shorter than upper, growing the smaller side a level at a time. A word
+		// at distance d from its side's start whose lower bound to the other end reaches upper is
+		// on no such ladder, so it is never visited. seen[n] is 1 + distance from a, or -(1 +
+		// distance from b).
+		auto seen = absl::flat_hash_map<word_id, int>{{a, 1}, {b, -1}};
+		auto front = std::vector<word_id>{a};
+		auto back = std::vector<word_id>{b};
+		auto next = std::vector<word_id>{};
+		auto side = 1; // +1 while front is the side grown from a
+		auto front_depth = std::uint32_t{0};
+		auto back_depth = std::uint32_t{0};
+		while (!front.empty() and !back.empty() and front_depth + back_depth + 1 < upper) {
+			if (front.size() > back.size()) {
+				std::swap(front, back);
+				std::swap(front_depth, back_depth);
+				side = -side;
+			}
+			auto const target = side > 0 ? b : a;
+			auto const depth = front_depth + 1;
+			auto meet = unreachable;
+			next.clear();
+			for (auto const curr : front) {
+				index_->for_each_neighbour(curr, [&](word_id n) {
+					auto const [it, fresh] = seen.try_emplace(n, 0);
+					if (!fresh) {
+						if (it->second * side < 0) {
+							auto const other = static_cast<std::uint32_t>(-it->second * side - 1);
+							meet = std::min(meet, depth + other);
+						}
+						return;
+					}
+					if (auto const rest = lower_bound(n, target); rest == unreachable or depth + rest >= upper) {
+						seen.erase(it);
+						return;
+					}
+					it->second = side * static_cast<int>(depth + 1);
+					next.push_back(n);
+				});
+			}
+			if (meet != unreachable) {
+				return meet;
+			}
+			std::swap(front, next);
+			front_depth = depth;
+		}
+		return upper;
+	}
+
+	auto distance_oracle::distance(std::string_view from, std::string_view to) const
+	   -> std::optional<std::size_t> {
+		auto const a = index_->find(from);
+		auto const b = index_->find(to);
+		if (!a or !b) {
+			return std::nullopt;
+		}
+		auto const d = distance(*a, *b);
+		if (d == unreachable) {
+			return std::nullopt;
+		}
+		return d;
+	}
+} // namespace word_ladder
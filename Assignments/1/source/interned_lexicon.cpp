@@ -0,0 +1,108 @@
+#include "comp6771/interned_lexicon.hpp"
+#include <absl/container/flat_hash_set.h>
+#include <range/v3/algorithm.hpp>
+#include <range/v3/range.hpp>
+#include <range/v3/view.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace word_ladder {
+	namespace views = ranges::views;
+
+	namespace {
+		auto extract_same_length(absl::flat_hash_set<std::string> const& lexicon, std::size_t length)
+		   -> std::vector<std::string_view> {
+			auto same_length = [length](std::string const& word) { return word.size() == length; };
+			return lexicon | views::filter(same_length) | ranges::to<std::vector<std::string_view>>;
+		}
+
+		// positions[p] gets every letter at position p of some word in chars
+		auto letters_by_position(std::span<char const> chars, std::size_t length) -> std::vector<byte_set> {
+			auto positions = std::vector<byte_set>(length);
+			for (auto i = std::size_t{0}; i < chars.size(); i += length) {
+				for (auto p = std::size_t{0}; p < length; ++p) {
+					positions[p].insert(chars[i + p]);
+				}
+			}
+			return positions;
+		}
+
+		auto letters_of(flat_array<byte_set> const& positions) noexcept -> byte_set {
+			auto letters = byte_set();
+			for (auto const& position : positions) {
+				letters |= position;
+			}
+			return letters;
+		}
+	} // namespace
+
+	interned_lexicon::interned_lexicon(absl::flat_hash_set<std::string> const& lexicon,
+	                                   std::size_t length)
+	: interned_lexicon(extract_same_length(lexicon, length), length) {}
+
+	interned_lexicon::interned_lexicon(std::vector<std::string_view> words, std::size_t length)
+	: length_(length) {
+		ranges::sort(words);
+		words.erase(std::unique(words.begin(), words.end()), words.end());
+
+		auto chars = std::vector<char>{};
+		chars.reserve(words.size() * length_);
+		for (auto const word : words) {
+			chars.insert(chars.end(), word.begin(), word.end());
+		}
+		chars_ = flat_array<char>(std::move(chars));
+		// words[id] is the word with that ID, which is exactly what the hash should map to
+		lookup_ = perfect_hash(words);
+		positions_ = flat_array<byte_set>(letters_by_position(chars_.span(), length_));
+		alphabet_ = letters_of(positions_);
+		word_count_ = words.size();
+	}
+
+	interned_lexicon::interned_lexicon(std::size_t length,
+	                                   flat_array<char> chars,
+	                                   perfect_hash lookup,
+	                                   flat_array<byte_set> positions)
+	: length_(length)
+	, chars_(std::move(chars))
+	, lookup_(std::move(lookup))
+	, positions_(std::move(positions))
+	, alphabet_(letters_of(positions_))
+	, word_count_(size()) {}
+
+	auto interned_lexicon::insert(std::string_view word) -> word_id {
+		++word_count_;
+		if (auto const id = interned(word)) {
+			erased_[*id] = false;
+			return *id;
+		}
+		auto const id = static_cast<word_id>(size());
+		if (id != 0 and word < this->word(id - 1)) {
+			ordered_ = false;
+		}
+		chars_.edit([word](std::vector<char>& chars) {
+			chars.insert(chars.end(), word.begin(), word.end());
+		});
+		auto const positions = positions_.edit();
+		for (auto p = std::size_t{0}; p < length_; ++p) {
+			positions[p].insert(word[p]);
+		}
+		for (auto const c : word) {
+			alphabet_.insert(c);
+		}
+		added_.try_emplace(std::string(word), id);
+		return id;
+	}
+
+	auto interned_lexicon::erase(word_id id) -> void {
+		if (erased_.size() <= id) {
+			erased_.resize(size());
+		}
+		erased_[id] = true;
+		--word_count_;
+	}
+} // namespace word_ladder
@@ -0,0 +1,58 @@
+#include "comp6771/ladder_range.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace word_ladder {
+	ladder_range::ladder_range(interned_lexicon const& words, detail::ladder_dag dag)
+	: words_(&words)
+	, dag_(std::move(dag)) {}
+
+	auto ladder_range::begin() const -> iterator {
+		return iterator(*this);
+	}
+
+	auto ladder_range::count() const -> std::uint64_t {
+		if (empty()) {
+			return 0;
+		}
+		// paths[v] is the number of ways from v to `to`. Children are nearer `to`, and so numbered
+		// lower, so filling paths in order always finds the children's counts ready.
+		constexpr auto most = std::numeric_limits<std::uint64_t>::max();
+		auto paths = std::vector<std::uint64_t>(dag_.nodes.size(), 0);
+		paths[dag_.to] = 1;
+		for (auto v = std::size_t{0}; v < paths.size(); ++v) {
+			for (auto i = dag_.first[v]; i < dag_.first[v + 1]; ++i) {
+				auto const more = paths[dag_.children[i]];
+				paths[v] = paths[v] > most - more ? most : paths[v] + more;
+			}
+		}
+		return paths[dag_.from];
+	}
+
+	ladder_range::iterator::iterator(ladder_range const& range)
+	: range_(&range) {
+		walk_.start(range.dag_);
+		update();
+	}
+
+	auto ladder_range::iterator::operator++() -> iterator& {
+		walk_.advance();
+		update();
+		return *this;
+	}
+
+	auto ladder_range::iterator::update() -> void {
+		if (walk_.done()) {
+			ladder_.clear();
+			return;
+		}
+		ladder_.resize(walk_.size());
+		for (auto i = walk_.changed(); i < walk_.size(); ++i) {
+			ladder_[i].assign(range_->words_->word(walk_.word(i)));
+		}
+	}
+} // namespace word_ladder
@@ -0,0 +1,57 @@
+#include "comp6771/ladder_writer.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+
+#include <unistd.h>
+
+namespace word_ladder {
+	auto ostream_sink::write(std::string_view bytes) -> void {
+		out_->write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	}
+
+	fd_sink::fd_sink(int fd, std::size_t buffer_size)
+	: fd_(fd)
+	, buffer_(std::max(buffer_size, std::size_t{1})) {}
+
+	fd_sink::~fd_sink() {
+		try {
+			flush();
+		}
+		catch (std::runtime_error const&) {
+			// Nowhere left to report it
+		}
+	}
+
+	auto fd_sink::write(std::string_view bytes) -> void {
+		while (!bytes.empty()) {
+			auto const n = std::min(bytes.size(), buffer_.size() - used_);
+			std::copy_n(bytes.data(), n, buffer_.data() + used_);
+			used_ += n;
+			bytes.remove_prefix(n);
+			if (used_ == buffer_.size()) {
+				flush();
+			}
+		}
+	}
+
+	auto fd_sink::flush() -> void {
+		auto const* data = buffer_.data();
+		auto left = used_;
+		used_ = 0;
+		while (left != 0) {
+			auto const n = ::write(fd_, data, left);
+			if (n < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				throw std::runtime_error("Unable to write file.");
+			}
+			data += n;
+			left -= static_cast<std::size_t>(n);
+		}
+	}
+} // namespace word_ladder
@@ -0,0 +1,109 @@
+#include "comp6771/mapped_file.hpp"
+#include <cerrno>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace word_ladder {
+	namespace {
+		// Closes the file descriptor it holds when it goes out of scope
+		class file_descriptor {
+		public:
+			explicit file_descriptor(int fd) noexcept
+			: fd_(fd) {}
+			file_descriptor(file_descriptor const&) = delete;
+			auto operator=(file_descriptor const&) -> file_descriptor& = delete;
+			~file_descriptor() {
+				if (fd_ >= 0) {
+					::close(fd_);
+				}
+			}
+
+			[[nodiscard]] auto get() const noexcept -> int {
+				return fd_;
+			}
+
+		private:
+			int fd_;
+		};
+
+		// Everything left to read from fd. Used for files whose size is not known up front: a pipe
+		// or a file under /proc reports a size of 0 however much it holds.
+		auto read_all(int fd) -> std::vector<char> {
+			constexpr auto chunk = std::size_t{1} << 16;
+			auto contents = std::vector<char>();
+			auto used = std::size_t{0};
+			while (true) {
+				contents.resize(used + chunk);
+				auto const n = ::read(fd, contents.data() + used, chunk);
+				if (n == 0) {
+					break;
+				}
+				if (n < 0) {
+					if (errno == EINTR) {
+						continue;
+					}
+					throw std::runtime_error("Unable to read file.");
+				}
+				used += static_cast<std::size_t>(n);
+			}
+			contents.resize(used);
+			return contents;
+		}
+	} // namespace
+
+	mapped_file::mapped_file(std::string const& path) {
+		auto const fd = file_descriptor(::open(path.c_str(), O_RDONLY));
+		if (fd.get() < 0) {
+			throw std::runtime_error("Unable to open file.");
+		}
+		struct stat info = {};
+		if (::fstat(fd.get(), &info) != 0) {
+			throw std::runtime_error("Unable to open file.");
+		}
+		if (!S_ISREG(info.st_mode)) {
+			contents_ = read_all(fd.get());
+			size_ = contents_.size();
+			return;
+		}
+		size_ = static_cast<std::size_t>(info.st_size);
+		// An empty file cannot be mapped, but it is still a (very short) file
+		if (size_ != 0) {
+			data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd.get(), 0);
+		}
+		if (data_ == MAP_FAILED) {
+			data_ = nullptr;
+			throw std::runtime_error("Unable to open file.");
+		}
+	}
+
+	mapped_file::mapped_file(mapped_file&& other) noexcept
+	: data_(std::exchange(other.data_, nullptr))
+	, size_(std::exchange(other.size_, 0))
+	, contents_(std::move(other.contents_)) {}
+
+	auto mapped_file::operator=(mapped_file&& other) noexcept -> mapped_file& {
+		if (this != &other) {
+			if (data_ != nullptr) {
+				::munmap(data_, size_);
+			}
+			data_ = std::exchange(other.data_, nullptr);
+			size_ = std::exchange(other.size_, 0);
+			contents_ = std::move(other.contents_);
+		}
+		return *this;
+	}
+
+	mapped_file::~mapped_file() {
+		if (data_ != nullptr) {
+			::munmap(data_, size_);
+		}
+	}
+} // namespace word_ladder
@@ -0,0 +1,91 @@
+#include "comp6771/mapped_lexicon.hpp"
+#include <absl/container/flat_hash_set.h>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace word_ladder {
+	namespace {
+		constexpr auto block_size = std::size_t{16};
+
+		// The same characters operator>> treats as separators: ' ' and '\t' through '\r'
+		constexpr auto is_space(char c) noexcept -> bool {
+			return c == ' ' or (c >= '\t' and c <= '\r');
+		}
+
+		// Bit k is set when block[k] is whitespace
+		auto space_mask(char const* block) noexcept -> std::uint32_t {
+#if defined(__SSE2__)
+			auto const bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block));
+			auto const space = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '));
+			// Signed compares, so bytes >= 0x80 are negative and never land in ['\t', '\r']
+			auto const control = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('\t' - 1)),
+			                                   _mm_cmplt_epi8(bytes, _mm_set1_epi8('\r' + 1)));
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(space, control)));
+#else
+			auto mask = std::uint32_t{0};
+			for (auto k = std::size_t{0}; k < block_size; ++k) {
+				mask |= std::uint32_t{is_space(block[k])} << k;
+			}
+			return mask;
+#endif
+		}
+
+		// Split text into words a block at a time. Within a block, a word starts at every non-space
+		// preceded by a space and ends at every space preceded by a non-space; `carry` says whether
+		// the byte just before the block was a space.
+		auto split(std::string_view text) -> std::vector<std::string_view> {
+			auto words = std::vector<std::string_view>{};
+			auto const* const data = text.data();
+			auto start = std::size_t{0};
+			auto carry = std::uint32_t{1};
+			auto emit = [&](std::size_t base, std::uint32_t spaces, std::size_t width) {
+				auto const all = (std::uint32_t{1} << width) - 1;
+				auto const before = ((spaces << 1) | carry) & all;
+				auto events = (~spaces & before & all) | (spaces & ~before & all);
+				while (events != 0) {
+					auto const k = static_cast<std::size_t>(std::countr_zero(events));
+					if (((spaces >> k) & 1) == 0) {
+						start = base + k;
+					}
+					else {
+						words.emplace_back(data + start, base + k - start);
+					}
+					events &= events - 1;
+				}
+				carry = (spaces >> (width - 1)) & 1;
+			};
+
+			auto i = std::size_t{0};
+			for (; i + block_size <= text.size(); i += block_size) {
+				emit(i, space_mask(data + i), block_size);
+			}
+			if (auto const rest = text.size() - i; rest != 0) {
+				auto tail = std::uint32_t{0};
+				for (auto k = std::size_t{0}; k < rest; ++k) {
+					tail |= std::uint32_t{is_space(data[i + k])} << k;
+				}
+				emit(i, tail, rest);
+			}
+			if (carry == 0) {
+				words.emplace_back(data + start, text.size() - start);
+			}
+			return words;
+		}
+	} // namespace
+
+	mapped_lexicon::mapped_lexicon(std::string const& path)
+	: file_(path)
+	, words_(split(file_.text())) {}
+
+	auto mapped_lexicon::to_set() const -> absl::flat_hash_set<std::string> {
+		return absl::flat_hash_set<std::string>(words_.begin(), words_.end());
+	}
+} // namespace word_ladder
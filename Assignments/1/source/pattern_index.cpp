@@ -0,0 +1,400 @@
+#include "comp6771/pattern_index.hpp"
+#include <absl/container/flat_hash_set.h>
+#include <range/v3/algorithm.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace word_ladder {
+	namespace {
+		// Compare two words as if the character at position p were a wildcard
+		auto masked_compare(std::string_view a, std::string_view b, std::size_t p) -> int {
+			if (auto const prefix = a.substr(0, p).compare(b.substr(0, p)); prefix != 0) {
+				return prefix;
+			}
+			return a.substr(p + 1).compare(b.substr(p + 1));
+		}
+
+		// Union-find over word IDs, with union by size and path halving
+		class disjoint_sets {
+		public:
+			explicit disjoint_sets(std::size_t n)
+			: parent_(n)
+			, size_(n, 1) {
+				std::iota(parent_.begin(), parent_.end(), word_id{0});
+			}
+
+			auto find(word_id x) -> word_id {
+				while (parent_[x] != x) {
+					parent_[x] = parent_[parent_[x]];
+					x = parent_[x];
+				}
+				return x;
+			}
+
+			auto unite(word_id a, word_id b) -> void {
+				a = find(a);
+				b = find(b);
+				if (a == b) {
+					return;
+				}
+				if (size_[a] < size_[b]) {
+					std::swap(a, b);
+				}
+				parent_[b] = a;
+				size_[a] += size_[b];
+			}
+
+		private:
+			std::vector<word_id> parent_;
+			std::vector<std::uint32_t> size_;
+		};
+
+		// The slices of each word's group, given every block of n members in group order and whether
+		// each member starts a new group. Block p holds the groups at position p.
+		auto slices_of(std::span<word_id const> members, std::vector<bool> const& starts, std::size_t n)
+		   -> std::vector<pattern_index::slice> {
+			auto const length = n == 0 ? 0 : members.size() / n;
+			auto buckets = std::vector<pattern_index::slice>(members.size());
+			for (auto first = std::size_t{0}; first < members.size();) {
+				auto last = first + 1;
+				while (last < members.size() and !starts[last]) {
+					++last;
+				}
+				auto const bucket = pattern_index::slice{static_cast<std::uint32_t>(first),
+				                                         static_cast<std::uint32_t>(last)};
+				for (auto i = first; i < last; ++i) {
+					buckets[std::size_t{members[i]} * length + first / n] = bucket;
+				}
+				first = last;
+			}
+			return buckets;
+		}
+
+		// Every group is a clique of neighbours, so joining each member to the next one connects
+		// exactly the words that have a ladder between them
+		auto components_of(std::span<word_id const> members, std::vector<bool> const& starts, std::size_t n)
+		   -> std::pair<std::vector<std::uint32_t>, std::vector<std::uint32_t>> {
+			auto sets = disjoint_sets(n);
+			for (auto i = std::size_t{1}; i < members.size(); ++i) {
+				if (!starts[i]) {
+					sets.unite(members[i - 1], members[i]);
+				}
+			}
+			auto components = std::vector<std::uint32_t>(n);
+			auto sizes = std::vector<std::uint32_t>{};
+			auto label = std::vector<std::uint32_t>(n, static_cast<std::uint32_t>(n));
+			for (auto id = word_id{0}; id < n; ++id) {
+				auto const root = sets.find(id);
+				if (label[root] == n) {
+					label[root] = static_cast<std::uint32_t>(sizes.size());
+					sizes.push_back(0);
+				}
+				components[id] = label[root];
+				++sizes[label[root]];
+			}
+			return {std::move(components), std::move(sizes)};
+		}
+
+		// An index over words whose members are already grouped block by block
+		auto assemble(interned_lexicon words,
+		              std::vector<word_id> members,
+		              std::vector<bool> const& starts,
+		              std::pair<std::vector<std::uint32_t>, std::vector<std::uint32_t>> found)
+		   -> pattern_index {
+			auto buckets = slices_of(members, starts, words.size());
+			auto [components, sizes] = std::move(found);
+			return pattern_index(std::move(words),
+			                     flat_array<word_id>(std::move(members)),
+			                     flat_array<pattern_index::slice>(std::move(buckets)),
+			                     flat_array<std::uint32_t>(std::move(components)),
+			                     flat_array<std::uint32_t>(std::move(sizes)));
+		}
+
+		auto group(interned_lexicon words) -> pattern_index {
+			auto const n = words.size();
+			auto members = std::vector<word_id>(words.length() * n);
+			auto starts = std::vector<bool>(members.size());
+			for (auto p = std::size_t{0}; p < words.length(); ++p) {
+				auto const block = std::span(members).subspan(p * n, n);
+				std::iota(block.begin(), block.end(), word_id{0});
+				// Group by pattern; IDs stay ascending within a group so neighbours come out sorted
+				ranges::sort(block, [&words, p](word_id a, word_id b) {
+					auto const cmp = masked_compare(words.word(a), words.word(b), p);
+					return cmp < 0 or (cmp == 0 and a < b);
+				});
+				for (auto i = std::size_t{0}; i < n; ++i) {
+					starts[p * n + i] =
+					   i == 0 or masked_compare(words.word(block[i - 1]), words.word(block[i]), p) != 0;
+				}
+			}
+			auto found = components_of(members, starts, n);
+			return assemble(std::move(words), std::move(members), starts, std::move(found));
+		}
+	} // namespace
+
+	pattern_index::pattern_index(absl::flat_hash_set<std::string> const& lexicon, std::size_t length)
+	: pattern_index(interned_lexicon(lexicon, length)) {}
+
+	pattern_index::pattern_index(interned_lexicon words)
+	: pattern_index(group(std::move(words))) {}
+
+	pattern_index::pattern_index(interned_lexicon words,
+	                             flat_array<word_id> members,
+	                             flat_array<slice> buckets,
+	                             flat_array<std::uint32_t> components,
+	                             flat_array<std::uint32_t> component_sizes)
+	: words_(std::move(words))
+	, members_(std::move(members))
+	, buckets_(std::move(buckets))
+	, components_(std::move(components))
+	, component_sizes_(std::move(component_sizes)) {}
+
+	// The word goes to the end of every group it joins, so only those groups move, and their old
+	// slices become garbage
+	auto pattern_index::insert(std::string_view word) -> word_id {
+		auto const n = length();
+		auto joins = std::vector<std::optional<word_id>>(n);
+		for (auto p = std::size_t{0}; p < n; ++p) {
+			joins[p] = group_member(word, p);
+		}
+		auto const id = words_.insert(word);
+		compact_ = false;
+
+		auto moved = std::vector<slice>(n);
+		members_.edit([&](std::vector<word_id>& members) {
+			for (auto p = std::size_t{0}; p < n; ++p) {
+				auto const first = members.size();
+				if (joins[p]) {
+					auto const [from, to] = buckets_[std::size_t{*joins[p]} * n + p];
+					for (auto i = from; i < to; ++i) {
+						auto const m = members[i];
+						members.push_back(m);
+					}
+					garbage_ += to - from;
+				}
+				members.push_back(id);
+				moved[p] = slice{static_cast<std::uint32_t>(first), static_cast<std::uint32_t>(members.size())};
+			}
+		});
+		buckets_.edit([&](std::vector<slice>& buckets) {
+			buckets.resize(size() * n);
+			for (auto p = std::size_t{0}; p < n; ++p) {
+				for (auto const m : members().subspan(moved[p].first, moved[p].last - moved[p].first)) {
+					buckets[std::size_t{m} * n + p] = moved[p];
+				}
+			}
+		});
+		components_.edit([this](std::vector<std::uint32_t>& components) { components.resize(size()); });
+		join_components(id);
+		if (garbage_ > members_.size() / 2) {
+			collect_garbage();
+		}
+		return id;
+	}
+
+	// Each group the word leaves closes the gap with its last member
+	auto pattern_index::erase(word_id id) -> void {
+		auto neighbours = std::vector<word_id>{};
+		for_each_neighbour(id, [&neighbours](word_id n) { neighbours.push_back(n); });
+		words_.erase(id);
+		compact_ = false;
+
+		auto const n = length();
+		auto const members = members_.edit();
+		auto const buckets = buckets_.edit();
+		for (auto p = std::size_t{0}; p < n; ++p) {
+			auto const [first, last] = buckets[std::size_t{id} * n + p];
+			*std::find(members.begin() + first, members.begin() + last, id) = members[last - 1];
+			auto const shrunk = slice{first, last - 1};
+			for (auto i = shrunk.first; i < shrunk.last; ++i) {
+				buckets[std::size_t{members[i]} * n + p] = shrunk;
+			}
+			buckets[std::size_t{id} * n + p] = slice{first, first};
+			++garbage_;
+		}
+		split_component(id, neighbours);
+		if (garbage_ > members_.size() / 2) {
+			collect_garbage();
+		}
+	}
+
+	auto pattern_index::compacted() const -> pattern_index {
+		auto words = std::vector<std::string_view>{};
+		words.reserve(word_count());
+		for (auto id = word_id{0}; id < size(); ++id) {
+			if (words_.contains(id)) {
+				words.push_back(word(id));
+			}
+		}
+		return pattern_index(interned_lexicon(std::move(words), length()));
+	}
+
+	auto pattern_index::matches(std::string_view pattern) const -> std::span<word_id const> {
+		auto const p = pattern.find('*');
+		if (pattern.size() != length() or p == std::string_view::npos) {
+			return {};
+		}
+		auto const member = group_member(pattern, p);
+		return member ? group_of(*member, p) : std::span<word_id const>();
+	}
+
+	// Any word that differs from `word` only at p is in that group, so trying each letter found at
+	// p is enough to find one
+	auto pattern_index::group_member(std::string_view word, std::size_t p) const
+	   -> std::optional<word_id> {
+		auto probe = std::string(word);
+		auto member = std::optional<word_id>();
+		words_.letters_at(p).for_each([&](char c) {
+			if (c != word[p] and !member) {
+				probe[p] = c;
+				member = find(probe);
+			}
+		});
+		return member;
+	}
+
+	auto pattern_index::collect_garbage() -> void {
+		auto const n = length();
+		auto members = std::vector<word_id>{};
+		members.reserve(members_.size() - garbage_);
+		auto buckets = std::vector<slice>(buckets_.size());
+		for (auto id = word_id{0}; id < size(); ++id) {
+			if (!words_.contains(id)) {
+				continue;
+			}
+			for (auto p = std::size_t{0}; p < n; ++p) {
+				// Each group is copied once, when its first member comes up
+				auto const group = group_of(id, p);
+				if (group.front() != id) {
+					continue;
+				}
+				auto const moved = slice{static_cast<std::uint32_t>(members.size()),
+				                         static_cast<std::uint32_t>(members.size() + group.size())};
+				members.insert(members.end(), group.begin(), group.end());
+				for (auto const m : group) {
+					buckets[std::size_t{m} * n + p] = moved;
+				}
+			}
+		}
+		members_ = flat_array<word_id>(std::move(members));
+		buckets_ = flat_array<slice>(std::move(buckets));
+		garbage_ = 0;
+	}
+
+	// id has just joined its groups. Whatever it now links up becomes one component, under the
+	// number of the biggest; the words of each smaller one are found by walking out from one of
+	// them without leaving it.
+	auto pattern_index::join_components(word_id id) -> void {
+		auto joined = std::vector<std::pair<std::uint32_t, word_id>>{};
+		for (auto p = std::size_t{0}; p < length(); ++p) {
+			auto const group = group_of(id, p);
+			auto const other = ranges::find_if(group, [id](word_id m) { return m != id; });
+			if (other != group.end()
+			    and ranges::find(joined, components_[*other], &std::pair<std::uint32_t, word_id>::first)
+			           == joined.end())
+			{
+				joined.emplace_back(components_[*other], *other);
+			}
+		}
+		if (joined.empty()) {
+			auto const c = new_component(1);
+			components_.edit()[id] = c;
+			return;
+		}
+
+		auto const sizes = component_sizes_.edit();
+		auto const into =
+		   ranges::max(joined, {}, [&sizes](auto const& c) { return sizes[c.first]; }).first;
+		auto const components = components_.edit();
+		components[id] = into;
+		++sizes[into];
+		auto stack = std::vector<word_id>{};
+		for (auto const& [c, start] : joined) {
+			if (c == into) {
+				continue;
+			}
+			components[start] = into;
+			stack.push_back(start);
+			while (!stack.empty()) {
+				auto const w = stack.back();
+				stack.pop_back();
+				for_each_neighbour(w, [&](word_id m) {
+					if (components[m] == c) {
+						components[m] = into;
+						stack.push_back(m);
+					}
+				});
+			}
+			sizes[into] += std::exchange(sizes[c], 0);
+			free_components_.push_back(c);
+		}
+	}
+
+	// id has just left its groups. Every word of its component was linked to it through one of its
+	// former neighbours, so the component holds together exactly when those still reach each other;
+	// a walk from the first stops as soon as it has met them all. If it runs out first, each
+	// neighbour it never met starts another part, and all but the biggest part get new numbers.
+	auto pattern_index::split_component(word_id id, std::span<word_id const> neighbours) -> void {
+		auto const c = components_[id];
+		if (neighbours.empty()) {
+			component_sizes_.edit()[c] = 0;
+			free_components_.push_back(c);
+			return;
+		}
+		auto seen = absl::flat_hash_set<word_id>{neighbours.front()};
+		auto unmet = absl::flat_hash_set<word_id>(neighbours.begin() + 1, neighbours.end());
+		auto parts = std::vector<std::vector<word_id>>{{neighbours.front()}};
+		auto walk = [&](std::vector<word_id>& part) {
+			for (auto i = std::size_t{0}; i < part.size() and (parts.size() > 1 or !unmet.empty()); ++i) {
+				for_each_neighbour(part[i], [&](word_id m) {
+					if (seen.insert(m).second) {
+						part.push_back(m);
+						unmet.erase(m);
+					}
+				});
+			}
+		};
+		walk(parts.front());
+		if (unmet.empty()) {
+			--component_sizes_.edit()[c];
+			return;
+		}
+		for (auto const start : neighbours) {
+			if (seen.insert(start).second) {
+				walk(parts.emplace_back(std::vector<word_id>{start}));
+			}
+		}
+		auto const biggest = static_cast<std::size_t>(
+		   ranges::max_element(parts, {}, &std::vector<word_id>::size) - parts.begin());
+		component_sizes_.edit()[c] = static_cast<std::uint32_t>(parts[biggest].size());
+		for (auto i = std::size_t{0}; i < parts.size(); ++i) {
+			if (i == biggest) {
+				continue;
+			}
+			auto const label = new_component(static_cast<std::uint32_t>(parts[i].size()));
+			auto const components = components_.edit();
+			for (auto const w : parts[i]) {
+				components[w] = label;
+			}
+		}
+	}
+
+	auto pattern_index::new_component(std::uint32_t size) -> std::uint32_t {
+		if (!free_components_.empty()) {
+			auto const c = free_components_.back();
+			free_components_.pop_back();
+			component_sizes_.edit()[c] = size;
+			return c;
+		}
+		auto const c = static_cast<std::uint32_t>(component_sizes_.size());
+		component_sizes_.edit([size](std::vector<std::uint32_t>& sizes) { sizes.push_back(size); });
+		return c;
+	}
+} // namespace word_ladder
@@ -0,0 +1,140 @@
+#include "comp6771/perfect_hash.hpp"
+#include <range/v3/algorithm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace word_ladder {
+	namespace {
+		// Give up on a salt once some bucket has tried this many seeds; it never happens in practice
+		constexpr auto max_seed = std::uint32_t{1} << 16;
+
+		// The finaliser from MurmurHash3: every input bit affects every output bit
+		constexpr auto mix(std::uint64_t x) noexcept -> std::uint64_t {
+			x ^= x >> 33;
+			x *= 0xff51afd7ed558ccdULL;
+			x ^= x >> 33;
+			x *= 0xc4ceb9fe1a85ec53ULL;
+			x ^= x >> 33;
+			return x;
+		}
+
+		auto hash(std::string_view key, std::uint64_t salt) noexcept -> std::uint64_t {
+			auto h = mix(salt + key.size());
+			while (key.size() >= sizeof(std::uint64_t)) {
+				auto word = std::uint64_t{0};
+				std::memcpy(&word, key.data(), sizeof(word));
+				h = mix(h ^ word);
+				key.remove_prefix(sizeof(word));
+			}
+			if (!key.empty()) {
+				auto word = std::uint64_t{0};
+				std::memcpy(&word, key.data(), key.size());
+				h = mix(h ^ word ^ 0x9e3779b97f4a7c15ULL);
+			}
+			return h;
+		}
+
+		auto bucket_of(std::uint64_t h, std::size_t buckets) noexcept -> std::size_t {
+			return static_cast<std::size_t>((h >> 32) % buckets);
+		}
+
+		auto slot_of(std::uint64_t h, std::uint32_t seed, std::size_t slots) noexcept -> std::size_t {
+			return static_cast<std::size_t>(mix(h ^ ((seed + 1) * 0x9e3779b97f4a7c15ULL)) % slots);
+		}
+	} // namespace
+
+	perfect_hash::perfect_hash(std::span<std::string_view const> keys) {
+		if (keys.empty()) {
+			return;
+		}
+		// About four keys per bucket and a fifth of the slots spare keeps the seed search short
+		auto const n = keys.size();
+		auto const bucket_count = n / 4 + 1;
+		auto const slot_count = n + n / 4 + 1;
+
+		auto hashes = std::vector<std::uint64_t>(n);
+		auto members = std::vector<std::uint32_t>(n);
+		auto first = std::vector<std::size_t>(bucket_count + 1);
+		auto order = std::vector<std::size_t>(bucket_count);
+		auto seeds = std::vector<std::uint32_t>(bucket_count);
+		auto slots = std::vector<std::uint32_t>(slot_count);
+		auto taken = std::vector<std::size_t>{};
+
+		for (salt_ = 0;; ++salt_) {
+			// Counting sort the keys by bucket
+			ranges::fill(first, 0);
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				hashes[i] = hash(keys[i], salt_);
+				++first[bucket_of(hashes[i], bucket_count) + 1];
+			}
+			std::partial_sum(first.begin(), first.end(), first.begin());
+			auto fill = first;
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				members[fill[bucket_of(hashes[i], bucket_count)]++] = static_cast<std::uint32_t>(i);
+			}
+
+			// Place the biggest buckets while the table is still empty
+			std::iota(order.begin(), order.end(), std::size_t{0});
+			ranges::stable_sort(order, [&first](std::size_t a, std::size_t b) {
+				return first[a + 1] - first[a] > first[b + 1] - first[b];
+			});
+			ranges::fill(slots, absent);
+
+			auto placed_all = true;
+			for (auto const b : order) {
+				auto const bucket = std::span(members).subspan(first[b], first[b + 1] - first[b]);
+				if (bucket.empty()) {
+					break;
+				}
+				auto seed = std::uint32_t{0};
+				for (; seed < max_seed; ++seed) {
+					taken.clear();
+					for (auto const i : bucket) {
+						auto const s = slot_of(hashes[i], seed, slot_count);
+						if (slots[s] != absent or ranges::find(taken, s) != taken.end()) {
+							break;
+						}
+						taken.push_back(s);
+					}
+					if (taken.size() == bucket.size()) {
+						break;
+					}
+				}
+				if (seed == max_seed) {
+					placed_all = false;
+					break;
+				}
+				seeds[b] = seed;
+				for (auto k = std::size_t{0}; k < bucket.size(); ++k) {
+					slots[taken[k]] = bucket[k];
+				}
+			}
+			if (placed_all) {
+				break;
+			}
+		}
+		seeds_ = flat_array<std::uint32_t>(std::move(seeds));
+		slots_ = flat_array<std::uint32_t>(std::move(slots));
+	}
+
+	perfect_hash::perfect_hash(std::uint64_t salt,
+	                           flat_array<std::uint32_t> seeds,
+	                           flat_array<std::uint32_t> slots)
+	: salt_(salt)
+	, seeds_(std::move(seeds))
+	, slots_(std::move(slots)) {}
+
+	auto perfect_hash::lookup(std::string_view key) const noexcept -> std::uint32_t {
+		if (slots_.size() == 0) {
+			return absent;
+		}
+		auto const h = hash(key, salt_);
+		return slots_[slot_of(h, seeds_[bucket_of(h, seeds_.size())], slots_.size())];
+	}
+} // namespace word_ladder
@@ -0,0 +1,498 @@
+#include "comp6771/solver.hpp"
+#include "comp6771/ladder_search.hpp"
+#include "comp6771/mapped_file.hpp"
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+#include <range/v3/algorithm.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace word_ladder {
+	solver::solver(absl::flat_hash_set<std::string> const& lexicon)
+	: solver(std::vector<std::string_view>(lexicon.begin(), lexicon.end())) {}
+
+	solver::solver(std::span<std::string_view const> words)
+	: solver([words] {
+		// One pass to split the lexicon by length, then intern and index each partition
+		auto partitions = absl::flat_hash_map<std::size_t, std::vector<std::string_view>>{};
+		for (auto const word : words) {
+			partitions[word.size()].push_back(word);
+		}
+		auto indexes = absl::flat_hash_map<std::size_t, std::shared_ptr<pattern_index>>{};
+		indexes.reserve(partitions.size());
+		for (auto& [length, partition] : partitions) {
+			indexes.try_emplace(
+			   length,
+			   std::make_shared<pattern_index>(interned_lexicon(std::move(partition), length)));
+		}
+		return indexes;
+	}()) {}
+
+	solver::solver(absl::flat_hash_map<std::size_t, std::shared_ptr<pattern_index>> indexes) {
+		auto current = std::make_shared<snapshot>();
+		current->reserve(indexes.size());
+		partitions_.reserve(indexes.size());
+		for (auto& [length, index] : indexes) {
+			current->try_emplace(length, index);
+			partitions_[length].live = std::move(index);
+		}
+		indexes_.store(std::move(current));
+	}
+
+	namespace {
+		// The file is a header, one record per partition, then the arrays those records point at.
+		// Every array starts on an 8-byte boundary so it can be used in place once mapped.
+		constexpr auto magic = std::array<char, 8>{'W', 'L', 'A', 'D', 'D', 'E', 'R', '1'};
+		constexpr auto version = std::uint32_t{4};
+		constexpr auto alignment = std::uint64_t{8};
+
+		struct file_header {
+			std::array<char, 8> magic;
+			std::uint32_t version;
+			std::uint32_t partitions;
+		};
+
+		// Where one array lives in the file, in bytes from the start, and how many elements it has
+		struct file_section {
+			std::uint64_t offset;
+			std::uint64_t count;
+		};
+
+		struct file_record {
+			std::uint64_t length;
+			std::uint64_t salt;
+			file_section chars;
+			file_section seeds;
+			file_section slots;
+			file_section positions;
+			file_section members;
+			file_section buckets;
+			file_section components;
+			file_section component_sizes;
+		};
+
+		auto invalid_file() -> std::runtime_error {
+			return std::runtime_error("Invalid lexicon file.");
+		}
+
+		auto align(std::uint64_t offset) noexcept -> std::uint64_t {
+			return (offset + alignment - 1) / alignment * alignment;
+		}
+
+		// Lays out arrays one after another from `offset`, each starting on a fresh boundary
+		class section_writer {
+		public:
+			explicit section_writer(std::uint64_t offset) noexcept
+			: offset_(offset) {}
+
+			template<typename T>
+			auto add(std::span<T const> array) -> file_section {
+				offset_ = align(offset_);
+				auto const section = file_section{offset_, array.size()};
+				offset_ += array.size_bytes();
+				arrays_.emplace_back(section.offset, std::as_bytes(array));
+				return section;
+			}
+
+			auto write(std::ofstream& out) const -> void {
+				auto const zeros = std::array<char, alignment>{};
+				auto at = static_cast<std::uint64_t>(out.tellp());
+				for (auto const& [offset, bytes] : arrays_) {
+					out.write(zeros.data(), static_cast<std::streamsize>(offset - at));
+					out.write(reinterpret_cast<char const*>(bytes.data()),
+					          static_cast<std::streamsize>(bytes.size()));
+					at = offset + bytes.size();
+				}
+			}
+
+		private:
+			std::uint64_t offset_;
+			std::vector<std::pair<std::uint64_t, std::span<std::byte const>>> arrays_;
+		};
+
+		// The array a section describes, borrowed from the mapped file, after checking it lies
+		// inside the file and is suitably aligned for T
+		template<typename T>
+		auto borrow(mapped_file const& file, file_section section) -> flat_array<T> {
+			if (section.offset % alignof(T) != 0 or section.offset > file.size()
+			    or section.count > (file.size() - section.offset) / sizeof(T))
+			{
+				throw invalid_file();
+			}
+			auto const* const first = reinterpret_cast<T const*>(file.data() + section.offset);
+			return flat_array<T>(std::span<T const>(first, section.count));
+		}
+
+		// Whether the arrays of one partition hold what save() writes, as far as anything reading
+		// them relies on: words in increasing order, hash slots that name words, each block of
+		// members listing every word once and inside its own group, and a component for every word
+		auto consistent(std::size_t length,
+		                std::span<char const> chars,
+		                std::span<std::uint32_t const> slots,
+		                std::span<word_id const> members,
+		                std::span<pattern_index::slice const> buckets,
+		                std::span<std::uint32_t const> components,
+		                std::size_t component_count) -> bool {
+			auto const n = length == 0 ? 0 : chars.size() / length;
+			auto const word = [&](std::size_t id) {
+				return std::string_view(chars.data() + id * length, length);
+			};
+			for (auto id = std::size_t{1}; id < n; ++id) {
+				if (word(id - 1) >= word(id)) {
+					return false;
+				}
+			}
+			auto const names_word = [n](std::uint32_t s) { return s < n or s == perfect_hash::absent; };
+			auto const numbered = [component_count](std::uint32_t c) { return c < component_count; };
+			if (not ranges::all_of(slots, names_word) or not ranges::all_of(components, numbered)) {
+				return false;
+			}
+			auto seen = std::vector<bool>(n);
+			for (auto p = std::size_t{0}; p < length; ++p) {
+				seen.assign(n, false);
+				for (auto i = p * n; i < (p + 1) * n; ++i) {
+					auto const id = members[i];
+					if (id >= n or seen[id]) {
+						return false;
+					}
+					seen[id] = true;
+					auto const [first, last] = buckets[std::size_t{id} * length + p];
+					if (first < p * n or first > i or i >= last or last > (p + 1) * n) {
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		template<typename Indexes>
+		auto find_index(Indexes const& indexes, std::size_t length) -> std::shared_ptr<pattern_index const> {
+			auto const it = indexes.find(length);
+			return it == indexes.end() ? nullptr : it->second;
+		}
+
+		template<typename Stats = detail::no_stats>
+		auto generate_with(pattern_index const* words,
+		                   std::string const& from,
+		                   std::string const& to,
+		                   search_mode mode,
+		                   detail::search_scratch& scratch,
+		                   Stats stats = {}) -> std::vector<std::vector<std::string>> {
+			if (words == nullptr) {
+				stats.query();
+				return {};
+			}
+			auto from_id = std::optional<word_id>();
+			auto to_id = std::optional<word_id>();
+			{
+				[[maybe_unused]] auto const timer = stats.time(&search_stats::lookup);
+				from_id = words->find(from);
+				to_id = words->find(to);
+			}
+			// Words in different components have no ladder, and there is no need to search to see it
+			if (!from_id || !to_id || !words->connected(*from_id, *to_id)) {
+				stats.query();
+				return {};
+			}
+			return detail::search(*from_id, *to_id, *words, mode, scratch, stats);
+		}
+	} // namespace
+
+	auto solver::save(std::string const& path) const -> void {
+		// Sorted by length so the same lexicon always makes the same file
+		auto const indexes = indexes_.load();
+		auto lengths = std::vector<std::size_t>{};
+		lengths.reserve(indexes->size());
+		for (auto const& [length, index] : *indexes) {
+			lengths.push_back(length);
+		}
+		ranges::sort(lengths);
+
+		auto const header = file_header{magic, version, static_cast<std::uint32_t>(lengths.size())};
+		auto records = std::vector<file_record>{};
+		auto sections = section_writer(sizeof(file_header) + lengths.size() * sizeof(file_record));
+		// An updated index may have gaps in its IDs and garbage among its members, so it is written
+		// as a fresh build would be
+		auto compacted = std::vector<pattern_index>{};
+		compacted.reserve(lengths.size());
+		for (auto const length : lengths) {
+			auto const* current = indexes->at(length).get();
+			auto const& index = current->compact() ? *current : compacted.emplace_back(current->compacted());
+			auto const& words = index.words();
+			auto& record = records.emplace_back();
+			record.length = length;
+			record.salt = words.lookup().salt();
+			record.chars = sections.add(words.chars());
+			record.seeds = sections.add(words.lookup().seeds());
+			record.slots = sections.add(words.lookup().slots());
+			record.positions = sections.add(words.positions());
+			record.members = sections.add(index.members());
+			record.buckets = sections.add(index.buckets());
+			record.components = sections.add(index.components());
+			record.component_sizes = sections.add(index.component_sizes());
+		}
+
+		auto out = std::ofstream(path, std::ios::binary | std::ios::trunc);
+		if (!out) {
+			throw std::runtime_error("Unable to open file.");
+		}
+		out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+		out.write(reinterpret_cast<char const*>(records.data()),
+		          static_cast<std::streamsize>(records.size() * sizeof(file_record)));
+		sections.write(out);
+		if (!out.flush()) {
+			throw std::runtime_error("Unable to write file.");
+		}
+	}
+
+	auto solver::open(std::string const& path) -> solver {
+		auto const file_ptr = std::make_shared<mapped_file const>(path);
+		auto const& file = *file_ptr;
+
+		auto header = file_header{};
+		if (file.size() < sizeof(header)) {
+			throw invalid_file();
+		}
+		std::memcpy(&header, file.data(), sizeof(header));
+		if (header.magic != magic or header.version != version
+		    or header.partitions > (file.size() - sizeof(header)) / sizeof(file_record))
+		{
+			throw invalid_file();
+		}
+
+		// Every array is checked before anything reads it, so a damaged or hostile file is rejected
+		// rather than sending a lookup, search or update outside an array
+		auto indexes = absl::flat_hash_map<std::size_t, std::shared_ptr<pattern_index>>{};
+		indexes.reserve(header.partitions);
+		for (auto i = std::size_t{0}; i < header.partitions; ++i) {
+			auto record = file_record{};
+			std::memcpy(&record, file.data() + sizeof(header) + i * sizeof(record), sizeof(record));
+			auto chars = borrow<char>(file, record.chars);
+			auto seeds = borrow<std::uint32_t>(file, record.seeds);
+			auto slots = borrow<std::uint32_t>(file, record.slots);
+			auto positions = borrow<byte_set>(file, record.positions);
+			auto members = borrow<word_id>(file, record.members);
+			auto buckets = borrow<pattern_index::slice>(file, record.buckets);
+			auto components = borrow<std::uint32_t>(file, record.components);
+			auto component_sizes = borrow<std::uint32_t>(file, record.component_sizes);
+
+			auto const size = record.length == 0 ? 0 : chars.size() / record.length;
+			if (chars.size() != size * record.length or members.size() != size * record.length
+			    or positions.size() != record.length or buckets.size() != members.size()
+			    or components.size() != size or component_sizes.size() > size
+			    or (seeds.size() == 0) != (slots.size() == 0)
+			    or indexes.contains(record.length)
+			    or not consistent(record.length,
+			                      chars.span(),
+			                      slots.span(),
+			                      members.span(),
+			                      buckets.span(),
+			                      components.span(),
+			                      component_sizes.size()))
+			{
+				throw invalid_file();
+			}
+			auto words = interned_lexicon(record.length,
+			                              std::move(chars),
+			                              perfect_hash(record.salt, std::move(seeds), std::move(slots)),
+			                              std::move(positions));
+			// Each partition borrows from the file, so it keeps the file mapped for as long as it lives
+			auto index = new pattern_index(std::move(words),
+			                               std::move(members),
+			                               std::move(buckets),
+			                               std::move(components),
+			                               std::move(component_sizes));
+			indexes.try_emplace(record.length,
+			                    std::shared_ptr<pattern_index>(index, [file_ptr](pattern_index const* p) {
+				                    delete p;
+			                    }));
+		}
+		return solver(std::move(indexes));
+	}
+
+	auto solver::insert(std::string_view word) -> bool {
+		if (word.empty()) {
+			return false;
+		}
+		auto const lock = std::scoped_lock(update_);
+		auto const it = partitions_.find(word.size());
+		if (it == partitions_.end()) {
+			auto& words = partitions_[word.size()];
+			words.live = std::make_shared<pattern_index>(interned_lexicon(std::vector{word}, word.size()));
+			publish(word.size(), words.live);
+			return true;
+		}
+		if (it->second.live->find(word)) {
+			return false;
+		}
+		apply(word.size(), it->second, update{true, std::string(word)});
+		return true;
+	}
+
+	auto solver::erase(std::string_view word) -> bool {
+		auto const lock = std::scoped_lock(update_);
+		auto const it = partitions_.find(word.size());
+		if (it == partitions_.end() or !it->second.live->find(word)) {
+			return false;
+		}
+		if (it->second.live->word_count() == 1) {
+			partitions_.erase(it);
+			publish(word.size(), nullptr);
+		}
+		else {
+			apply(word.size(), it->second, update{false, std::string(word)});
+		}
+		return true;
+	}
+
+	// An update costs what pattern_index's own insert and erase do, twice: once to catch the spare
+	// up and once more for itself. Only while a query still holds the spare is the live index
+	// copied instead.
+	auto solver::apply(std::size_t length, partition& words, update u) -> void {
+		auto const run = [](pattern_index& index, update const& next) {
+			if (next.insert) {
+				index.insert(next.word);
+			}
+			else {
+				index.erase(*index.find(next.word));
+			}
+		};
+		auto next = std::shared_ptr<pattern_index>();
+		if (words.spare != nullptr and words.spare.use_count() == 1) {
+			// Make whatever the last query to let go of it did happen before the changes below
+			std::atomic_thread_fence(std::memory_order_acquire);
+			next = std::move(words.spare);
+			run(*next, words.missed);
+		}
+		else {
+			next = std::make_shared<pattern_index>(*words.live);
+		}
+		run(*next, u);
+		words.spare = std::exchange(words.live, std::move(next));
+		words.missed = std::move(u);
+		publish(length, words.live);
+	}
+
+	auto solver::publish(std::size_t length, std::shared_ptr<pattern_index const> words) -> void {
+		auto next = std::make_shared<snapshot>(*indexes_.load());
+		if (words == nullptr) {
+			next->erase(length);
+		}
+		else {
+			(*next)[length] = std::move(words);
+		}
+		indexes_.store(std::move(next));
+	}
+
+	auto solver::generate(std::string const& from, std::string const& to, search_mode mode) const
+	   -> std::vector<std::vector<std::string>> {
+		auto& scratch = detail::thread_scratch();
+		return generate_with(index(from.size()).get(), from, to, mode, scratch);
+	}
+
+	auto solver::generate(std::string const& from,
+	                      std::string const& to,
+	                      search_mode mode,
+	                      search_stats& stats) const -> std::vector<std::vector<std::string>> {
+		auto& scratch = detail::thread_scratch();
+		auto const words = index(from.size());
+		return generate_with(words.get(), from, to, mode, scratch, detail::record_stats(stats));
+	}
+
+	auto solver::ladders(std::string const& from, std::string const& to, search_mode mode) const
+	   -> ladder_range {
+		auto const words = index(from.size());
+		if (words == nullptr) {
+			return {};
+		}
+		// The range refers to the index, so it keeps this version of it alive
+		auto range = word_ladder::ladders(from, to, *words, mode);
+		range.hold(words);
+		return range;
+	}
+
+	auto solver::count_ladders(std::string const& from, std::string const& to, search_mode mode) const
+	   -> std::uint64_t {
+		return ladders(from, to, mode).count();
+	}
+
+	auto solver::first_k_ladders(std::string const& from,
+	                             std::string const& to,
+	                             std::size_t k,
+	                             search_mode mode) const -> std::vector<std::vector<std::string>> {
+		auto const words = index(from.size());
+		if (words == nullptr) {
+			return {};
+		}
+		return word_ladder::first_k_ladders(from, to, *words, k, mode);
+	}
+
+	auto solver::generate_many(std::span<std::pair<std::string, std::string> const> queries,
+	                           search_mode mode) const
+	   -> std::vector<std::vector<std::vector<std::string>>> {
+		std::call_once(pool_started_, [this] { pool_ = std::make_unique<work_stealing_pool>(); });
+		return generate_many(queries, *pool_, mode);
+	}
+
+	auto solver::generate_many(std::span<std::pair<std::string, std::string> const> queries,
+	                           work_stealing_pool& pool,
+	                           search_mode mode) const
+	   -> std::vector<std::vector<std::vector<std::string>>> {
+		// Each worker writes only its own queries' slots and searches with its own thread's scratch,
+		// which it keeps from one batch to the next. The whole batch runs against one snapshot,
+		// however the lexicon changes meanwhile.
+		auto const indexes = indexes_.load();
+		auto results = std::vector<std::vector<std::vector<std::string>>>(queries.size());
+		pool.parallel_for(queries.size(), [&](std::size_t i, std::size_t) {
+			auto const& [from, to] = queries[i];
+			results[i] = generate_with(find_index(*indexes, from.size()).get(),
+			                           from,
+			                           to,
+			                           mode,
+			                           detail::thread_scratch());
+		});
+		return results;
+	}
+
+	auto solver::generate_many(std::span<std::pair<std::string, std::string> const> queries,
+	                           work_stealing_pool& pool,
+	                           search_mode mode,
+	                           search_stats& stats) const
+	   -> std::vector<std::vector<std::vector<std::string>>> {
+		// As above, with each worker recording into its own stats, totalled at the end
+		auto const indexes = indexes_.load();
+		auto results = std::vector<std::vector<std::vector<std::string>>>(queries.size());
+		auto worker_stats = std::vector<search_stats>(pool.size());
+		pool.parallel_for(queries.size(), [&](std::size_t i, std::size_t worker) {
+			auto const& [from, to] = queries[i];
+			results[i] = generate_with(find_index(*indexes, from.size()).get(),
+			                           from,
+			                           to,
+			                           mode,
+			                           detail::thread_scratch(),
+			                           detail::record_stats(worker_stats[worker]));
+		});
+		for (auto const& s : worker_stats) {
+			stats += s;
+		}
+		return results;
+	}
+
+	auto solver::index(std::size_t length) const -> std::shared_ptr<pattern_index const> {
+		return find_index(*indexes_.load(), length);
+	}
+} // namespace word_ladder
@@ -1,106 +1,129 @@
 #include "comp6771/word_ladder.hpp"
-#include <absl/container/flat_hash_map.h>
+#include "comp6771/ladder_search.hpp"
 #include <absl/container/flat_hash_set.h>
-#include <range/v3/algorithm/find.hpp>
-#include <range/v3/algorithm/sort.hpp>
-#include <range/v3/iterator.hpp>
-#include <range/v3/range.hpp>
-#include <range/v3/view.hpp>
-#include <queue>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
 namespace word_ladder {
-	namespace views = ranges::views;
-	auto extract_same_length(std::string const& from, absl::flat_hash_set<std::string> const& lexicon)
-	   -> absl::flat_hash_set<std::string> {
-		auto same_length = [from](auto& lexicon) { return lexicon.size() == from.length(); };
-		return lexicon | views::filter(same_length) | ranges::to<absl::flat_hash_set<std::string>>;
-	}
-
-	// Use dfs to find the shorest path
-	auto dfs(std::string const& curr,
-	         std::string const& des,
-	         absl::flat_hash_map<std::string, std::vector<std::string>> const& neighbors,
-	         absl::flat_hash_map<std::string, int> const& depth,
-	         std::vector<std::string>& path,
-	         std::vector<std::vector<std::string>>& res) -> void {
-		path.push_back(curr);
-		// If the curr is the des, add this path into res and return
-		if (curr == des) {
-			res.push_back(path);
-			return;
+	auto generate(std::string const& from,
+	              std::string const& to,
+	              absl::flat_hash_set<std::string> const& lexicon,
+	              search_mode mode) -> std::vector<std::vector<std::string>> {
+		// Intern the words which have the same length as from and to
+		auto const words = interned_lexicon(lexicon, from.size());
+		auto const from_id = words.find(from);
+		auto const to_id = words.find(to);
+		if (!from_id || !to_id) {
+			return {};
 		}
+		return detail::search(*from_id, *to_id, words, mode);
+	}
 
-		// Need to check whether curr is in neighbours
-		if (neighbors.find(curr) != neighbors.end()) {
-			for (auto const& n : neighbors.at(curr)) {
-				// If the depth of the neighbour is curr + 1, that means they are adjacent
-				if (depth.at(n) == depth.at(curr) + 1) {
-					dfs(n, des, neighbors, depth, path, res);
-					path.pop_back(); // Drop last node due to dfs
-				}
+	namespace {
+		template<typename Stats>
+		auto generate_over(std::string const& from,
+		                   std::string const& to,
+		                   pattern_index const& index,
+		                   search_mode mode,
+		                   Stats stats) -> std::vector<std::vector<std::string>> {
+			auto from_id = std::optional<word_id>();
+			auto to_id = std::optional<word_id>();
+			{
+				[[maybe_unused]] auto const timer = stats.time(&search_stats::lookup);
+				from_id = index.find(from);
+				to_id = index.find(to);
+			}
+			// Words in different components have no ladder, and there is no need to search to see it
+			if (!from_id || !to_id || !index.connected(*from_id, *to_id)) {
+				stats.query();
+				return {};
 			}
+			auto& scratch = detail::thread_scratch();
+			return detail::search(*from_id, *to_id, index, mode, scratch, stats);
 		}
+	} // namespace
+
+	auto generate(std::string const& from,
+	              std::string const& to,
+	              pattern_index const& index,
+	              search_mode mode) -> std::vector<std::vector<std::string>> {
+		return generate_over(from, to, index, mode, detail::no_stats{});
 	}
 
 	auto generate(std::string const& from,
 	              std::string const& to,
-	              absl::flat_hash_set<std::string> const& lexicon)
-	   -> std::vector<std::vector<std::string>> {
-	    // extrace words which has same length with the from and to
-		absl::flat_hash_set<std::string> copy_lexicon = extract_same_length(from, lexicon);
-		auto all_paths = std::vector<std::vector<std::string>>{};
-		auto visited = absl::flat_hash_set<std::string>{};
-		auto neighbors = absl::flat_hash_map<std::string, std::vector<std::string>>{};
-		auto depth = absl::flat_hash_map<std::string, int>{};
-		auto path_q = std::queue<std::string>();
+	              pattern_index const& index,
+	              search_mode mode,
+	              search_stats& stats) -> std::vector<std::vector<std::string>> {
+		return generate_over(from, to, index, mode, detail::record_stats(stats));
+	}
 
-		path_q.push(from);
-		depth[from] = 0;
+	auto generate(std::string const& from, std::string const& to, distance_oracle const& oracle)
+	   -> std::vector<std::vector<std::string>> {
+		auto const& index = oracle.index();
+		auto const from_id = index.find(from);
+		auto const to_id = index.find(to);
+		if (!from_id || !to_id || !index.connected(*from_id, *to_id)) {
+			return {};
+		}
+		auto const length = oracle.distance(*from_id, *to_id);
+		if (length == distance_oracle::unreachable) {
+			return {};
+		}
+		auto& scratch = detail::thread_scratch();
+		scratch.reset();
+		scratch.prepare(index.size());
+		if (*from_id != *to_id) {
+			// A word joining level d is d - 1 steps from `from`, so it is on a shortest ladder only if
+			// it can still reach `to` in the steps that are left
+			detail::forward_bfs(*from_id, *to_id, index, scratch, [&](word_id n, int d) {
+				auto const rest = oracle.lower_bound(n, *to_id);
+				return rest == distance_oracle::unreachable
+				       or static_cast<std::uint32_t>(d - 1) + rest > length;
+			});
+		}
+		return detail::collect(*from_id, *to_id, index, scratch);
+	}
 
-		int d = 1; // depth of nodes
+	auto ladders(std::string const& from,
+	             std::string const& to,
+	             pattern_index const& index,
+	             search_mode mode) -> ladder_range {
+		auto const from_id = index.find(from);
+		auto const to_id = index.find(to);
+		if (!from_id || !to_id || !index.connected(*from_id, *to_id)) {
+			return {};
+		}
+		auto& scratch = detail::thread_scratch();
+		detail::explore(*from_id, *to_id, index, mode, scratch);
+		return ladder_range(index.words(), detail::shortest_path_dag(*from_id, *to_id, index, scratch));
+	}
 
-		while (!path_q.empty()) {
-			unsigned long size_q = path_q.size();
+	auto count_ladders(std::string const& from,
+	                   std::string const& to,
+	                   pattern_index const& index,
+	                   search_mode mode) -> std::uint64_t {
+		return ladders(from, to, index, mode).count();
+	}
 
-			for (unsigned long i = 0; i < size_q; ++i) {
-				std::string curr = path_q.front();
-				path_q.pop();
-				auto new_curr = curr;
-				for (char& ch : new_curr) // Each time replace one character
-				{
-					auto old_ch = ch;
-					for (char c = 'a'; c <= 'z'; ++c) {
-						// Keep a copy of the original character
-						ch = c;
-						// If can find the revised word, that means curr can reach to this word
-						if (copy_lexicon.find(new_curr) != copy_lexicon.end()) {
-							neighbors[curr].push_back(new_curr);
-							visited.emplace(new_curr);
-							if (depth.find(new_curr) == depth.end()) {
-								depth[new_curr] = d;
-								path_q.push(new_curr);
-							}
-						}
-					}
-					ch = old_ch; // Roll back the revised character
-				}
-			}
-			++d; // Depth + 1 when for loop end
-			for (auto& nodes : visited) {
-				copy_lexicon.erase(nodes);
+	auto first_k_ladders(std::string const& from,
+	                     std::string const& to,
+	                     pattern_index const& index,
+	                     std::size_t k,
+	                     search_mode mode) -> std::vector<std::vector<std::string>> {
+		auto result = std::vector<std::vector<std::string>>{};
+		if (k == 0) {
+			return result;
+		}
+		for (auto const& ladder : ladders(from, to, index, mode)) {
+			result.push_back(ladder);
+			if (result.size() == k) {
+				break;
 			}
-			visited.clear();
 		}
-
-		auto single_path = std::vector<std::string>();
-		// Use dfs to find the shortes path
-		dfs(from, to, neighbors, depth, single_path, all_paths);
-
-		// sort paths
-		ranges::sort(all_paths, std::less<>());
-		return all_paths;
+		return result;
 	}
-
 } // namespace word_ladder
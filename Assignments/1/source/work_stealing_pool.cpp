@@ -0,0 +1,128 @@
+#include "comp6771/work_stealing_pool.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+namespace word_ladder {
+	work_stealing_pool::work_stealing_pool(std::size_t workers) {
+		workers = std::max(workers, std::size_t{1});
+		queues_.reserve(workers);
+		for (auto w = std::size_t{0}; w < workers; ++w) {
+			queues_.push_back(std::make_unique<queue>());
+		}
+		// Worker 0 is whichever thread calls parallel_for
+		threads_.reserve(workers - 1);
+		for (auto w = std::size_t{1}; w < workers; ++w) {
+			threads_.emplace_back([this, w](std::stop_token stop) { work(std::move(stop), w); });
+		}
+	}
+
+	// Destroying the jthreads asks them to stop, which wakes them up, and then joins them
+	work_stealing_pool::~work_stealing_pool() = default;
+
+	auto work_stealing_pool::parallel_for(std::size_t count,
+	                                      std::function<void(std::size_t, std::size_t)> const& body)
+	   -> void {
+		if (count == 0) {
+			return;
+		}
+		auto const job = std::lock_guard(job_);
+
+		// Deal out an even, contiguous share to every worker
+		auto const n = size();
+		for (auto w = std::size_t{0}; w < n; ++w) {
+			auto const lock = std::lock_guard(queues_[w]->mutex);
+			queues_[w]->first = count * w / n;
+			queues_[w]->last = count * (w + 1) / n;
+		}
+		{
+			auto const lock = std::lock_guard(mutex_);
+			body_ = &body;
+			error_ = nullptr;
+			running_ = n - 1;
+			++generation_;
+		}
+		start_.notify_all();
+
+		run(0);
+
+		auto lock = std::unique_lock(mutex_);
+		finish_.wait(lock, [this] { return running_ == 0; });
+		body_ = nullptr;
+		if (error_) {
+			std::rethrow_exception(std::exchange(error_, nullptr));
+		}
+	}
+
+	auto work_stealing_pool::run(std::size_t worker) -> void {
+		while (auto const i = next(worker)) {
+			try {
+				(*body_)(*i, worker);
+			} catch (...) {
+				auto const lock = std::lock_guard(mutex_);
+				if (!error_) {
+					error_ = std::current_exception();
+				}
+			}
+		}
+	}
+
+	// Take the front of our own share; failing that, steal the back half of someone else's.
+	// Only one queue is ever locked at a time, so workers cannot deadlock on each other.
+	auto work_stealing_pool::next(std::size_t worker) -> std::optional<std::size_t> {
+		auto& own = *queues_[worker];
+		{
+			auto const lock = std::lock_guard(own.mutex);
+			if (own.first < own.last) {
+				return own.first++;
+			}
+		}
+
+		auto const n = size();
+		for (auto k = std::size_t{1}; k < n; ++k) {
+			auto& victim = *queues_[(worker + k) % n];
+			auto first = std::size_t{0};
+			auto last = std::size_t{0};
+			{
+				auto const lock = std::lock_guard(victim.mutex);
+				if (victim.first == victim.last) {
+					continue;
+				}
+				last = victim.last;
+				first = last - (last - victim.first + 1) / 2;
+				victim.last = first;
+			}
+			auto const lock = std::lock_guard(own.mutex);
+			own.first = first + 1;
+			own.last = last;
+			return first;
+		}
+		return std::nullopt;
+	}
+
+	auto work_stealing_pool::work(std::stop_token stop, std::size_t worker) -> void {
+		auto seen = std::size_t{0};
+		while (true) {
+			{
+				auto lock = std::unique_lock(mutex_);
+				if (!start_.wait(lock, stop, [this, seen] { return generation_ != seen; })) {
+					return;
+				}
+				seen = generation_;
+			}
+			run(worker);
+			{
+				auto const lock = std::lock_guard(mutex_);
+				--running_;
+			}
+			finish_.notify_one();
+		}
+	}
+} // namespace word_ladder
@@ -0,0 +1,57 @@
+#ifndef COMP6771_TEST_WORD_LADDER_LEXICONS_HPP
+#define COMP6771_TEST_WORD_LADDER_LEXICONS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+
+namespace testing {
+	// A lexicon small enough to know every ladder in it by hand. cat -> dog has exactly two
+	// shortest ladders, zzz is cut off from every other word, and there are words of other lengths.
+	inline auto small_lexicon() -> absl::flat_hash_set<std::string> {
+		return {"at", "it", "in", "cat", "cot", "cog", "dog", "dot", "bat", "bot", "zzz", "ate"};
+	}
+
+	// `count` distinct words of `length` letters drawn from the first `alphabet` lowercase letters.
+	// A small alphabet packs the words densely, so most pairs have several ladders between them.
+	inline auto
+	random_lexicon(std::size_t count, std::size_t length, int alphabet, unsigned seed = 6771)
+	   -> absl::flat_hash_set<std::string> {
+		auto rng = std::mt19937(seed);
+		auto letter = std::uniform_int_distribution<int>(0, alphabet - 1);
+		auto lexicon = absl::flat_hash_set<std::string>{};
+		while (lexicon.size() < count) {
+			auto word = std::string(length, 'a');
+			for (auto& c : word) {
+				c = static_cast<char>('a' + letter(rng));
+			}
+			lexicon.insert(std::move(word));
+		}
+		return lexicon;
+	}
+
+	// Every ordered pair of words of the same length among the first `count` words of lexicon, in
+	// sorted order
+	inline auto some_pairs(absl::flat_hash_set<std::string> const& lexicon, std::size_t count)
+	   -> std::vector<std::pair<std::string, std::string>> {
+		auto words = std::vector<std::string>(lexicon.begin(), lexicon.end());
+		std::sort(words.begin(), words.end());
+		words.resize(std::min(count, words.size()));
+		auto pairs = std::vector<std::pair<std::string, std::string>>{};
+		for (auto const& from : words) {
+			for (auto const& to : words) {
+				if (from.size() == to.size()) {
+					pairs.emplace_back(from, to);
+				}
+			}
+		}
+		return pairs;
+	}
+} // namespace testing
+
+#endif // COMP6771_TEST_WORD_LADDER_LEXICONS_HPP
@@ -0,0 +1,86 @@
+#include "comp6771/word_ladder.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "comp6771/distance_oracle.hpp"
+#include "comp6771/pattern_index.hpp"
+#include "comp6771/solver.hpp"
+#include "lexicons.hpp"
+
+using ladders_t = std::vector<std::vector<std::string>>;
+using word_ladder::search_mode;
+
+TEST_CASE("generate finds every shortest ladder") {
+	auto const lexicon = testing::small_lexicon();
+	auto const mode = GENERATE(search_mode::forward, search_mode::bidirectional);
+
+	SECTION("A ladder of one step") {
+		CHECK(word_ladder::generate("at", "it", lexicon, mode) == ladders_t{{"at", "it"}});
+	}
+
+	SECTION("Several ladders come out in lexicographic order") {
+		auto const expected = ladders_t{{"cat", "cot", "cog", "dog"}, {"cat", "cot", "dot", "dog"}};
+		CHECK(word_ladder::generate("cat", "dog", lexicon, mode) == expected);
+	}
+
+	SECTION("Words with no ladder between them give none") {
+		CHECK(word_ladder::generate("cat", "zzz", lexicon, mode).empty());
+		CHECK(word_ladder::generate("ate", "cat", lexicon, mode).empty());
+	}
+
+	SECTION("Words missing from the lexicon give none") {
+		auto const index = word_ladder::pattern_index(lexicon, 3);
+		CHECK(word_ladder::generate("cat", "cut", index, mode).empty());
+		CHECK(word_ladder::generate("cut", "cat", index, mode).empty());
+	}
+}
+
+TEST_CASE("Every way of generating gives the same ladders") {
+	auto const length = std::size_t{4};
+	auto const lexicon = testing::random_lexicon(120, length, 4);
+	auto const index = word_ladder::pattern_index(lexicon, length);
+	auto const oracle = word_ladder::distance_oracle(index, 4);
+	auto const solver = word_ladder::solver(lexicon);
+	auto const pairs = testing::some_pairs(lexicon, 12);
+
+	auto const many = solver.generate_many(pairs);
+	REQUIRE(many.size() == pairs.size());
+
+	auto found = std::size_t{0};
+	for (auto i = std::size_t{0}; i < pairs.size(); ++i) {
+		auto const& [from, to] = pairs[i];
+		CAPTURE(from, to);
+		auto const expected = word_ladder::generate(from, to, lexicon, search_mode::forward);
+		CHECK(std::is_sorted(expected.begin(), expected.end()));
+		CHECK(std::all_of(expected.begin(), expected.end(), [&](auto const& ladder) {
+			return ladder.front() == from and ladder.back() == to
+			       and ladder.size() == expected.front().size();
+		}));
+		found += expected.size();
+
+		for (auto const mode : {search_mode::forward, search_mode::bidirectional}) {
+			CHECK(word_ladder::generate(from, to, lexicon, mode) == expected);
+			auto const letters = word_ladder::lowercase{};
+			CHECK(word_ladder::generate(from, to, lexicon, letters, mode) == expected);
+			CHECK(word_ladder::generate(from, to, index, mode) == expected);
+			CHECK(solver.generate(from, to, mode) == expected);
+		}
+		CHECK(word_ladder::generate(from, to, oracle) == expected);
+		CHECK(many[i] == expected);
+	}
+	// The lexicon is dense enough that the comparisons above are not all between empty results
+	CHECK(found > pairs.size());
+
+	// Later batches run on the same threads, and batches from different threads take turns
+	auto again = std::vector<std::vector<std::vector<std::vector<std::string>>>>(2);
+	auto other = std::thread([&] { again[0] = solver.generate_many(pairs); });
+	again[1] = solver.generate_many(pairs);
+	other.join();
+	CHECK(again[0] == many);
+	CHECK(again[1] == many);
+}
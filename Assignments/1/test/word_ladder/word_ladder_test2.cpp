@@ -0,0 +1,94 @@
+#include "comp6771/word_ladder.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "comp6771/ladder_range.hpp"
+#include "comp6771/pattern_index.hpp"
+#include "comp6771/solver.hpp"
+#include "lexicons.hpp"
+
+using ladders_t = std::vector<std::vector<std::string>>;
+using word_ladder::search_mode;
+
+namespace {
+	auto collect(word_ladder::ladder_range const& range) -> ladders_t {
+		auto ladders = ladders_t{};
+		for (auto const& ladder : range) {
+			ladders.push_back(ladder);
+		}
+		return ladders;
+	}
+} // namespace
+
+TEST_CASE("ladder_range walks the ladders generate returns") {
+	auto const lexicon = testing::small_lexicon();
+	auto const index = word_ladder::pattern_index(lexicon, 3);
+
+	SECTION("In the same order") {
+		auto const range = word_ladder::ladders("cat", "dog", index);
+		CHECK(not range.empty());
+		CHECK(range.count() == 2);
+		CHECK(collect(range) == word_ladder::generate("cat", "dog", index));
+	}
+
+	SECTION("Stepping past a ladder keeps the words it shares with the next") {
+		auto const range = word_ladder::ladders("cat", "dog", index);
+		auto it = range.begin();
+		CHECK(*it == std::vector<std::string>{"cat", "cot", "cog", "dog"});
+		++it;
+		CHECK(it->size() == 4);
+		CHECK(*it == std::vector<std::string>{"cat", "cot", "dot", "dog"});
+		++it;
+		CHECK(it == std::default_sentinel);
+	}
+
+	SECTION("Unconnected words give an empty range") {
+		auto const range = word_ladder::ladders("cat", "zzz", index);
+		CHECK(range.empty());
+		CHECK(range.count() == 0);
+		CHECK(range.begin() == range.end());
+	}
+
+	SECTION("A default range is empty") {
+		auto const range = word_ladder::ladder_range();
+		CHECK(range.empty());
+		CHECK(range.begin() == range.end());
+	}
+}
+
+TEST_CASE("ladders, count_ladders and first_k_ladders agree with generate") {
+	auto const length = std::size_t{4};
+	auto const lexicon = testing::random_lexicon(120, length, 4);
+	auto const index = word_ladder::pattern_index(lexicon, length);
+	auto const solver = word_ladder::solver(lexicon);
+	auto const mode = GENERATE(search_mode::forward, search_mode::bidirectional);
+
+	for (auto const& [from, to] : testing::some_pairs(lexicon, 10)) {
+		CAPTURE(from, to);
+		auto const expected = word_ladder::generate(from, to, index, mode);
+		CHECK(collect(word_ladder::ladders(from, to, index, mode)) == expected);
+		CHECK(collect(solver.ladders(from, to, mode)) == expected);
+		CHECK(word_ladder::count_ladders(from, to, index, mode) == expected.size());
+		CHECK(solver.count_ladders(from, to, mode) == expected.size());
+
+		for (auto const k : {std::size_t{0}, std::size_t{1}, std::size_t{3}, expected.size() + 5}) {
+			auto const kept = static_cast<std::ptrdiff_t>(std::min(k, expected.size()));
+			auto const prefix = ladders_t(expected.begin(), expected.begin() + kept);
+			CHECK(word_ladder::first_k_ladders(from, to, index, k, mode) == prefix);
+			CHECK(solver.first_k_ladders(from, to, k, mode) == prefix);
+		}
+	}
+}
+
+TEST_CASE("A solver's ladder_range outlives updates to the solver") {
+	auto solver = word_ladder::solver(testing::small_lexicon());
+	auto const range = solver.ladders("cat", "dog");
+	CHECK(solver.erase("cot"));
+	CHECK(solver.first_k_ladders("cat", "dog", 2) == ladders_t{{"cat", "bat", "bot", "dot", "dog"}});
+	CHECK(collect(range) == ladders_t{{"cat", "cot", "cog", "dog"}, {"cat", "cot", "dot", "dog"}});
+}
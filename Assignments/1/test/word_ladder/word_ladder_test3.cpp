@@ -0,0 +1,116 @@
+#include "comp6771/ladder_writer.hpp"
+
+#include <array>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "comp6771/pattern_index.hpp"
+#include "comp6771/solver.hpp"
+#include "comp6771/word_ladder.hpp"
+#include "lexicons.hpp"
+
+namespace {
+	// The text write_ladders should produce for ladders
+	auto as_text(std::vector<std::vector<std::string>> const& ladders) -> std::string {
+		auto text = std::string{};
+		for (auto const& ladder : ladders) {
+			for (auto i = std::size_t{0}; i < ladder.size(); ++i) {
+				text += ladder[i];
+				text += i + 1 < ladder.size() ? ' ' : '\n';
+			}
+		}
+		return text;
+	}
+
+	// Everything written to file so far
+	auto contents(std::FILE* file) -> std::string {
+		std::rewind(file);
+		auto text = std::string{};
+		auto buffer = std::array<char, 256>{};
+		while (auto const n = std::fread(buffer.data(), 1, buffer.size(), file)) {
+			text.append(buffer.data(), n);
+		}
+		return text;
+	}
+} // namespace
+
+TEST_CASE("write_ladders writes text through an ostream_sink") {
+	auto const lexicon = testing::random_lexicon(120, 4, 4);
+	auto const index = word_ladder::pattern_index(lexicon, 4);
+
+	for (auto const& [from, to] : testing::some_pairs(lexicon, 8)) {
+		CAPTURE(from, to);
+		auto const expected = word_ladder::generate(from, to, index);
+		auto out = std::ostringstream();
+		auto sink = word_ladder::ostream_sink(out);
+		CHECK(word_ladder::write_ladders(from, to, index, sink) == expected.size());
+		CHECK(out.str() == as_text(expected));
+	}
+}
+
+TEST_CASE("write_ladders writes binary as word counts and IDs") {
+	auto const lexicon = testing::small_lexicon();
+	auto const index = word_ladder::pattern_index(lexicon, 3);
+	auto out = std::ostringstream();
+	auto sink = word_ladder::ostream_sink(out);
+	auto const format = word_ladder::ladder_format::binary;
+	CHECK(word_ladder::write_ladders("cat", "dog", index, sink, format) == 2);
+
+	auto const bytes = out.str();
+	REQUIRE(bytes.size() == 2 * 5 * sizeof(std::uint32_t));
+	auto ids = std::vector<std::uint32_t>(bytes.size() / sizeof(std::uint32_t));
+	std::memcpy(ids.data(), bytes.data(), bytes.size());
+
+	auto words = std::vector<std::string>{};
+	for (auto const ladder : {std::size_t{0}, std::size_t{5}}) {
+		CHECK(ids[ladder] == 4);
+		for (auto i = std::size_t{1}; i <= 4; ++i) {
+			words.emplace_back(index.word(ids[ladder + i]));
+		}
+	}
+	CHECK(words == std::vector<std::string>{"cat", "cot", "cog", "dog", "cat", "cot", "dot", "dog"});
+}
+
+TEST_CASE("fd_sink buffers what it is given and writes it all out") {
+	auto const lexicon = testing::random_lexicon(120, 4, 4);
+	auto const solver = word_ladder::solver(lexicon);
+	auto* const file = std::tmpfile();
+	REQUIRE(file != nullptr);
+
+	auto expected = std::string{};
+	auto written = std::uint64_t{0};
+	{
+		// A buffer smaller than a line, so most lines go out in more than one write()
+		auto sink = word_ladder::fd_sink(fileno(file), 7);
+		for (auto const& [from, to] : testing::some_pairs(lexicon, 6)) {
+			auto const ladders = solver.generate(from, to);
+			CHECK(solver.write_ladders(from, to, sink) == ladders.size());
+			expected += as_text(ladders);
+			written += ladders.size();
+		}
+		sink.flush();
+		CHECK(contents(file) == expected);
+		// The destructor flushes whatever is left after the last write
+		std::fseek(file, 0, SEEK_END);
+		sink.write("tail\n");
+	}
+	CHECK(written > 0);
+	CHECK(contents(file) == expected + "tail\n");
+	std::fclose(file);
+}
+
+TEST_CASE("write_ladders writes nothing when there is no ladder") {
+	auto const solver = word_ladder::solver(testing::small_lexicon());
+	auto out = std::ostringstream();
+	auto sink = word_ladder::ostream_sink(out);
+	CHECK(solver.write_ladders("cat", "zzz", sink) == 0);
+	CHECK(solver.write_ladders("cat", "cut", sink) == 0);
+	CHECK(solver.write_ladders("word", "ward", sink) == 0);
+	CHECK(out.str().empty());
+}
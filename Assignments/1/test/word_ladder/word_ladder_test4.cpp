@@ -0,0 +1,299 @@
+#include "comp6771/solver.hpp"
+
+#include <catch2/catch.hpp>
+#include <range/v3/algorithm.hpp>
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "comp6771/pattern_index.hpp"
+#include "comp6771/word_ladder.hpp"
+#include "lexicons.hpp"
+
+using ladders_t = std::vector<std::vector<std::string>>;
+
+namespace {
+	auto temporary(std::string const& name) -> std::string {
+		return (std::filesystem::temp_directory_path() / name).string();
+	}
+
+	// solver answers every query among `pairs` just as a solver built afresh from lexicon would
+	auto matches(word_ladder::solver const& solver,
+	             absl::flat_hash_set<std::string> const& lexicon,
+	             std::vector<std::pair<std::string, std::string>> const& pairs) -> bool {
+		auto const fresh = word_ladder::solver(lexicon);
+		for (auto const& [from, to] : pairs) {
+			if (solver.generate(from, to) != fresh.generate(from, to)) {
+				return false;
+			}
+		}
+		return true;
+	}
+} // namespace
+
+TEST_CASE("insert and erase change the ladders a solver finds") {
+	auto solver = word_ladder::solver(testing::small_lexicon());
+
+	SECTION("Inserting a word can add ladders") {
+		CHECK(solver.insert("cog") == false);
+		CHECK(solver.insert("cag"));
+		CHECK(solver.insert("dag"));
+		CHECK(solver.generate("cat", "dog")
+		      == ladders_t{{"cat", "cag", "cog", "dog"},
+		                   {"cat", "cag", "dag", "dog"},
+		                   {"cat", "cot", "cog", "dog"},
+		                   {"cat", "cot", "dot", "dog"}});
+	}
+
+	SECTION("Inserting a word can join two components") {
+		CHECK(solver.insert("zat"));
+		CHECK(solver.generate("cat", "zzz").empty());
+		CHECK(solver.insert("zzt"));
+		CHECK(solver.generate("cat", "zzz") == ladders_t{{"cat", "zat", "zzt", "zzz"}});
+	}
+
+	SECTION("Erasing a word can split a component") {
+		CHECK(solver.erase("cut") == false);
+		CHECK(solver.erase("cot"));
+		CHECK(solver.erase("bot"));
+		CHECK(solver.generate("cat", "dog").empty());
+		CHECK(solver.generate("cog", "dog") == ladders_t{{"cog", "dog"}});
+	}
+
+	SECTION("Words of a new length get a partition of their own") {
+		CHECK(solver.index(4) == nullptr);
+		CHECK(solver.insert("word"));
+		CHECK(solver.insert("ward"));
+		CHECK(solver.generate("word", "ward") == ladders_t{{"word", "ward"}});
+		CHECK(solver.erase("word"));
+		CHECK(solver.erase("ward"));
+		CHECK(solver.index(4) == nullptr);
+		CHECK(solver.insert("") == false);
+	}
+
+	SECTION("An index taken before an update does not see it") {
+		auto const before = solver.index(3);
+		CHECK(solver.erase("cot"));
+		CHECK(before->find("cot").has_value());
+		CHECK(not solver.index(3)->find("cot").has_value());
+		// Nor does it see the updates after that
+		CHECK(solver.insert("cag"));
+		CHECK(solver.erase("bat"));
+		CHECK(not before->find("cag").has_value());
+		CHECK(before->find("bat").has_value());
+		CHECK(solver.generate("cat", "dog") == ladders_t{{"cat", "cag", "cog", "dog"}});
+	}
+}
+
+TEST_CASE("Queries running alongside updates see one version of the lexicon or the other") {
+	auto solver = word_ladder::solver(testing::small_lexicon());
+	auto const without = solver.generate("cat", "dog");
+	REQUIRE(solver.insert("cag"));
+	auto const with = solver.generate("cat", "dog");
+	auto done = std::atomic<bool>(false);
+	auto torn = std::atomic<int>(0);
+	auto reader = std::thread([&] {
+		while (not done) {
+			auto const found = solver.generate("cat", "dog");
+			if (found != with and found != without) {
+				++torn;
+			}
+		}
+	});
+	for (auto i = 0; i < 200; ++i) {
+		CHECK(solver.erase("cag"));
+		CHECK(solver.insert("cag"));
+	}
+	done = true;
+	reader.join();
+	CHECK(torn == 0);
+	CHECK(solver.generate("cat", "dog") == with);
+}
+
+TEST_CASE("A pattern_index updated in place matches one built afresh") {
+	auto lexicon = testing::random_lexicon(80, 4, 4);
+	auto index = word_ladder::pattern_index(lexicon, 4);
+	auto rng = std::mt19937(6771);
+	auto const neighbours = [](word_ladder::pattern_index const& words, std::string const& word) {
+		auto found = std::vector<std::string>{};
+		words.for_each_neighbour(*words.find(word), [&](word_ladder::word_id n) {
+			found.emplace_back(words.word(n));
+		});
+		ranges::sort(found);
+		return found;
+	};
+
+	for (auto const& word : testing::random_lexicon(60, 4, 4, 3)) {
+		if (auto const id = index.find(word)) {
+			index.erase(*id);
+			lexicon.erase(word);
+		}
+		else if (rng() % 2 == 0) {
+			CHECK(index.word(index.insert(word)) == word);
+			lexicon.insert(word);
+		}
+	}
+	CHECK(not index.compact());
+
+	auto const fresh = word_ladder::pattern_index(lexicon, 4);
+	REQUIRE(index.word_count() == lexicon.size());
+	auto total = std::size_t{0};
+	for (auto const size : index.component_sizes()) {
+		total += size;
+	}
+	CHECK(total == lexicon.size());
+	for (auto const& word : lexicon) {
+		auto const id = *index.find(word);
+		CHECK(neighbours(index, word) == neighbours(fresh, word));
+		CHECK(index.component_sizes()[index.component(id)]
+		      == fresh.component_sizes()[fresh.component(*fresh.find(word))]);
+	}
+	for (auto const& [from, to] : testing::some_pairs(lexicon, 20)) {
+		CHECK(index.connected(*index.find(from), *index.find(to))
+		      == fresh.connected(*fresh.find(from), *fresh.find(to)));
+	}
+
+	auto const compacted = index.compacted();
+	CHECK(compacted.compact());
+	CHECK(ranges::equal(compacted.words().chars(), fresh.words().chars()));
+	CHECK(ranges::equal(compacted.members(), fresh.members()));
+	CHECK(ranges::equal(compacted.components(), fresh.components()));
+}
+
+TEST_CASE("A run of updates leaves the same solver as building afresh") {
+	auto lexicon = testing::random_lexicon(60, 4, 4);
+	auto solver = word_ladder::solver(lexicon);
+	auto const candidates = testing::random_lexicon(40, 4, 4, 1);
+	auto const pairs = testing::some_pairs(testing::random_lexicon(8, 4, 4, 2), 8);
+
+	auto rng = std::mt19937(6771);
+	for (auto const& word : candidates) {
+		auto const present = lexicon.contains(word);
+		if (rng() % 2 == 0) {
+			CHECK(solver.insert(word) == not present);
+			lexicon.insert(word);
+		}
+		else {
+			CHECK(solver.erase(word) == present);
+			lexicon.erase(word);
+		}
+		CHECK(matches(solver, lexicon, pairs));
+	}
+	CHECK(matches(solver, lexicon, testing::some_pairs(lexicon, 10)));
+}
+
+TEST_CASE("A saved solver opens with the same answers") {
+	auto lexicon = testing::random_lexicon(150, 4, 4);
+	lexicon.merge(testing::small_lexicon());
+	auto const built = word_ladder::solver(lexicon);
+	auto const path = temporary("word_ladder_test4.bin");
+	built.save(path);
+
+	auto opened = word_ladder::solver::open(path);
+	auto const pairs = testing::some_pairs(lexicon, 12);
+	CHECK(matches(opened, lexicon, pairs));
+	for (auto const length : {std::size_t{2}, std::size_t{3}, std::size_t{4}}) {
+		auto const a = built.index(length);
+		auto const b = opened.index(length);
+		REQUIRE(b != nullptr);
+		CHECK(ranges::equal(a->words().chars(), b->words().chars()));
+		CHECK(ranges::equal(a->members(), b->members()));
+		CHECK(ranges::equal(a->components(), b->components()));
+		for (auto p = std::size_t{0}; p < length; ++p) {
+			CHECK(a->words().letters_at(p) == b->words().letters_at(p));
+		}
+	}
+
+	SECTION("Saving again gives the same file") {
+		auto const again = temporary("word_ladder_test4_again.bin");
+		opened.save(again);
+		auto read = [](std::string const& p) {
+			auto in = std::ifstream(p, std::ios::binary);
+			return std::string(std::istreambuf_iterator<char>(in), {});
+		};
+		CHECK(read(again) == read(path));
+		std::filesystem::remove(again);
+	}
+
+	SECTION("An updated solver saves what a fresh build would") {
+		auto updated = word_ladder::solver(lexicon);
+		CHECK(updated.insert("cag"));
+		CHECK(updated.erase("cot"));
+		CHECK(updated.insert("cot"));
+		CHECK(updated.erase("cag"));
+		auto const again = temporary("word_ladder_test4_updated.bin");
+		updated.save(again);
+		auto read = [](std::string const& p) {
+			auto in = std::ifstream(p, std::ios::binary);
+			return std::string(std::istreambuf_iterator<char>(in), {});
+		};
+		CHECK(read(again) == read(path));
+		std::filesystem::remove(again);
+	}
+
+	SECTION("An opened solver can still be updated") {
+		CHECK(opened.insert("cag"));
+		CHECK(opened.erase("cot"));
+		lexicon.insert("cag");
+		lexicon.erase("cot");
+		CHECK(matches(opened, lexicon, testing::some_pairs(lexicon, 12)));
+	}
+
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("open rejects what save did not write") {
+	auto const missing = temporary("word_ladder_test4_missing.bin");
+	std::filesystem::remove(missing);
+	CHECK_THROWS_AS(word_ladder::solver::open(missing), std::runtime_error);
+
+	auto const path = temporary("word_ladder_test4_bad.bin");
+	{
+		auto out = std::ofstream(path, std::ios::binary);
+		out << "not a lexicon file at all";
+	}
+	CHECK_THROWS_WITH(word_ladder::solver::open(path), "Invalid lexicon file.");
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("open rejects a damaged file rather than reading outside it") {
+	auto const path = temporary("word_ladder_test4_damaged.bin");
+	word_ladder::solver(testing::small_lexicon()).save(path);
+	auto const saved = [&path] {
+		auto in = std::ifstream(path, std::ios::binary);
+		return std::string(std::istreambuf_iterator<char>(in), {});
+	}();
+	auto const write = [&path](std::string const& bytes) {
+		auto out = std::ofstream(path, std::ios::binary | std::ios::trunc);
+		out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	};
+
+	write(saved.substr(0, saved.size() / 2));
+	CHECK_THROWS_WITH(word_ladder::solver::open(path), "Invalid lexicon file.");
+
+	// Any 32-bit field, whether an offset, a word ID or a group boundary, set to a value far past
+	// the end of everything: the file is either turned away or still answers queries safely
+	auto rejected = std::size_t{0};
+	for (auto at = std::size_t{0}; at + 4 <= saved.size(); at += 4) {
+		auto damaged = saved;
+		damaged.replace(at, 4, 4, '\xff');
+		write(damaged);
+		try {
+			auto const opened = word_ladder::solver::open(path);
+			static_cast<void>(opened.generate("cat", "dog"));
+			static_cast<void>(opened.generate("at", "in"));
+		} catch (std::runtime_error const& e) {
+			CHECK(std::string(e.what()) == "Invalid lexicon file.");
+			++rejected;
+		}
+	}
+	CHECK(rejected > 0);
+	std::filesystem::remove(path);
+}
@@ -0,0 +1,124 @@
+#include "comp6771/mapped_lexicon.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "absl/container/flat_hash_set.h"
+#include "comp6771/word_ladder.hpp"
+
+namespace {
+	auto temporary(std::string const& name) -> std::string {
+		return (std::filesystem::temp_directory_path() / name).string();
+	}
+
+	auto write(std::string const& path, std::string const& text) -> void {
+		auto out = std::ofstream(path, std::ios::binary | std::ios::trunc);
+		out.write(text.data(), static_cast<std::streamsize>(text.size()));
+	}
+
+	// The words operator>> finds in text, which is what the loader has to agree with
+	auto extracted(std::string const& text) -> std::vector<std::string> {
+		auto in = std::istringstream(text);
+		auto words = std::vector<std::string>{};
+		for (auto word = std::string(); in >> word;) {
+			words.push_back(word);
+		}
+		return words;
+	}
+
+	auto words_of(word_ladder::mapped_lexicon const& lexicon) -> std::vector<std::string> {
+		return std::vector<std::string>(lexicon.words().begin(), lexicon.words().end());
+	}
+} // namespace
+
+TEST_CASE("mapped_lexicon splits a file into the words operator>> would read") {
+	auto const path = temporary("word_ladder_test5.txt");
+
+	SECTION("A short file is read without a whole block of it") {
+		write(path, "cat dog\n");
+		auto const lexicon = word_ladder::mapped_lexicon(path);
+		CHECK(words_of(lexicon) == std::vector<std::string>{"cat", "dog"});
+	}
+
+	SECTION("Words may cross block boundaries and end the file") {
+		// 16 bytes of words and spaces, then a tail of 7 with no newline at the end
+		auto const text = std::string("abcdefghij\tklm\r\nnopqrst");
+		write(path, text);
+		auto const lexicon = word_ladder::mapped_lexicon(path);
+		CHECK(words_of(lexicon) == std::vector<std::string>{"abcdefghij", "klm", "nopqrst"});
+	}
+
+	SECTION("Repeats are kept in words() and dropped by to_set()") {
+		write(path, "  at\vit\fat \n");
+		auto const lexicon = word_ladder::mapped_lexicon(path);
+		CHECK(words_of(lexicon) == std::vector<std::string>{"at", "it", "at"});
+		CHECK(lexicon.to_set() == absl::flat_hash_set<std::string>{"at", "it"});
+		CHECK(word_ladder::read_lexicon(path) == lexicon.to_set());
+	}
+
+	SECTION("An empty file or one of only spaces has no words") {
+		write(path, "");
+		CHECK(word_ladder::mapped_lexicon(path).words().empty());
+		write(path, " \t\n\n\r ");
+		CHECK(word_ladder::mapped_lexicon(path).words().empty());
+	}
+
+	SECTION("Every length of file, whatever bytes it holds") {
+		auto rng = std::mt19937(6771);
+		auto const bytes = std::string(" \t\n\v\f\rab\x7f\x80\xe9\xff", 12);
+		auto pick = std::uniform_int_distribution<std::size_t>(0, bytes.size() - 1);
+		for (auto size = std::size_t{0}; size <= 70; ++size) {
+			auto text = std::string(size, ' ');
+			for (auto& c : text) {
+				c = bytes[pick(rng)];
+			}
+			CAPTURE(size);
+			write(path, text);
+			auto const lexicon = word_ladder::mapped_lexicon(path);
+			CHECK(words_of(lexicon) == extracted(text));
+		}
+	}
+
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("read_lexicon reports a file it cannot open") {
+	auto const missing = temporary("word_ladder_test5_missing.txt");
+	std::filesystem::remove(missing);
+	CHECK_THROWS_AS(word_ladder::read_lexicon(missing), std::runtime_error);
+	CHECK_THROWS_AS(word_ladder::mapped_lexicon(missing), std::runtime_error);
+}
+
+TEST_CASE("Files that cannot be mapped are read instead") {
+	// A pipe reports a size of 0 however much is written to it, as do the files under /proc
+	auto const path = temporary("word_ladder_test5.fifo");
+	std::filesystem::remove(path);
+	REQUIRE(::mkfifo(path.c_str(), 0600) == 0);
+
+	// More than one read's worth, so the words run across the reads
+	auto text = std::string();
+	for (auto i = 0; i < 20000; ++i) {
+		text += "word" + std::to_string(i % 1000) + '\n';
+	}
+	auto writer = std::thread([&] { write(path, text); });
+	auto const lexicon = word_ladder::mapped_lexicon(path);
+	writer.join();
+	CHECK(words_of(lexicon) == extracted(text));
+	CHECK(lexicon.to_set().size() == 1000);
+
+	writer = std::thread([&] { write(path, "cat dog\n"); });
+	CHECK(word_ladder::read_lexicon(path) == absl::flat_hash_set<std::string>{"cat", "dog"});
+	writer.join();
+
+	std::filesystem::remove(path);
+}
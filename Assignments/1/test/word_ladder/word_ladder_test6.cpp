@@ -0,0 +1,115 @@
+#include "comp6771/alphabet.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "comp6771/interned_lexicon.hpp"
+#include "comp6771/pattern_index.hpp"
+#include "comp6771/solver.hpp"
+#include "comp6771/word_ladder.hpp"
+
+using ladders_t = std::vector<std::vector<std::string>>;
+
+namespace {
+	template<typename Alphabet>
+	auto letters_of(Alphabet const& alphabet) -> std::string {
+		auto letters = std::string();
+		alphabet.for_each([&letters](char c) { letters += c; });
+		return letters;
+	}
+} // namespace
+
+TEST_CASE("byte_set holds any byte values") {
+	auto set = word_ladder::byte_set();
+	CHECK(set.empty());
+	for (auto const c : {'z', '\xff', 'A', '\0', '\x80', '0'}) {
+		set.insert(c);
+	}
+	CHECK(not set.empty());
+	CHECK(set.contains('\xff'));
+	CHECK(set.contains('\0'));
+	CHECK(not set.contains('a'));
+	// Visited in order of unsigned byte value, so bytes past 0x7f come last
+	CHECK(letters_of(set) == std::string("\0" "0Az\x80\xff", 6));
+
+	auto other = word_ladder::byte_set();
+	other.insert('a');
+	other.insert('z');
+	CHECK(set != other);
+	set |= other;
+	CHECK(set.contains('a'));
+	CHECK(letters_of(set) == std::string("\0" "0Aaz\x80\xff", 7));
+}
+
+TEST_CASE("Compile-time alphabets") {
+	STATIC_REQUIRE(word_ladder::lowercase::letters.size() == 26);
+	STATIC_REQUIRE(word_ladder::alphanumeric::letters.size() == 62);
+	STATIC_REQUIRE(word_ladder::alphanumeric::contains('Q'));
+	STATIC_REQUIRE(not word_ladder::lowercase::contains('Q'));
+	STATIC_REQUIRE(word_ladder::digits::letters.front() == '0');
+	// Letters are tried in the order they are listed
+	CHECK(letters_of(word_ladder::alphabet<'x', 'a', 'm'>{}) == "xam");
+	CHECK(letters_of(word_ladder::join<word_ladder::digits, word_ladder::uppercase>{}).substr(8, 4)
+	      == "89AB");
+}
+
+TEST_CASE("Lexicons need not be lowercase ASCII") {
+	auto const lexicon =
+	   absl::flat_hash_set<std::string>{"A1", "A2", "B2", "b2", "at", "\xe9t", "\xe9\xe9", "Z9"};
+	auto const mode = GENERATE(word_ladder::search_mode::forward, word_ladder::search_mode::bidirectional);
+
+	SECTION("Capitals and digits") {
+		auto const expected = ladders_t{{"A1", "A2", "B2"}};
+		CHECK(word_ladder::generate("A1", "B2", lexicon, mode) == expected);
+		CHECK(word_ladder::generate("A1", "B2", lexicon, word_ladder::alphanumeric{}, mode) == expected);
+		// Never tries a capital or a digit, so never reaches A2 or B2
+		CHECK(word_ladder::generate("A1", "B2", lexicon, word_ladder::lowercase{}, mode).empty());
+		// Case matters: B2 and b2 are different words, one step apart
+		CHECK(word_ladder::generate("B2", "b2", lexicon, mode) == ladders_t{{"B2", "b2"}});
+		CHECK(word_ladder::generate("A1", "Z9", lexicon, mode).empty());
+	}
+
+	SECTION("Bytes outside ASCII") {
+		auto const expected = ladders_t{{"at", "\xe9t", "\xe9\xe9"}};
+		CHECK(word_ladder::generate("at", "\xe9\xe9", lexicon, mode) == expected);
+		auto const index = word_ladder::pattern_index(lexicon, 2);
+		CHECK(word_ladder::generate("at", "\xe9\xe9", index, mode) == expected);
+		auto const solver = word_ladder::solver(lexicon);
+		CHECK(solver.generate("at", "\xe9\xe9", mode) == expected);
+	}
+}
+
+TEST_CASE("interned_lexicon only tries the letters some word has at each position") {
+	auto const lexicon =
+	   absl::flat_hash_set<std::string>{"cat", "cot", "cog", "dog", "\xe9og", "ab", "zz"};
+	auto const words = word_ladder::interned_lexicon(lexicon, 3);
+	CHECK(letters_of(words.letters_at(0)) == "cd\xe9");
+	CHECK(letters_of(words.letters_at(1)) == "ao");
+	CHECK(letters_of(words.letters_at(2)) == "gt");
+	CHECK(letters_of(words.alphabet()) == "acdgot\xe9");
+
+	auto const cot = *words.find("cot");
+	auto neighbours = std::vector<std::string>{};
+	auto probes = std::size_t{0};
+	auto const collect = [&](word_ladder::word_id n) { neighbours.emplace_back(words.word(n)); };
+	auto const count = [&probes] { ++probes; };
+
+	SECTION("With the lexicon's own letters") {
+		words.for_each_neighbour(cot, collect, count);
+		// Two other letters at the front, one in the middle and one at the end
+		CHECK(probes == 4);
+	}
+
+	SECTION("With a fixed alphabet, letters outside the lexicon's are skipped") {
+		words.for_each_neighbour(cot, word_ladder::lowercase{}, collect, count);
+		// The byte outside ASCII is not lowercase, so it is never tried
+		CHECK(probes == 3);
+	}
+
+	std::sort(neighbours.begin(), neighbours.end());
+	CHECK(neighbours == std::vector<std::string>{"cat", "cog"});
+}
@@ -0,0 +1,105 @@
+#include "comp6771/distance_oracle.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "comp6771/pattern_index.hpp"
+#include "lexicons.hpp"
+
+namespace {
+	auto constexpr unreachable = word_ladder::distance_oracle::unreachable;
+
+	// Every word's distance from `from`, found with a plain BFS over the index
+	auto distances_from(word_ladder::pattern_index const& index, word_ladder::word_id from)
+	   -> std::vector<std::uint32_t> {
+		auto distances = std::vector<std::uint32_t>(index.size(), unreachable);
+		auto queue = std::deque<word_ladder::word_id>{from};
+		distances[from] = 0;
+		while (not queue.empty()) {
+			auto const id = queue.front();
+			queue.pop_front();
+			index.for_each_neighbour(id, [&](word_ladder::word_id n) {
+				if (distances[n] == unreachable) {
+					distances[n] = distances[id] + 1;
+					queue.push_back(n);
+				}
+			});
+		}
+		return distances;
+	}
+} // namespace
+
+TEST_CASE("distance_oracle agrees with a BFS") {
+	auto const length = std::size_t{4};
+	// Sparse enough that some words are cut off from others
+	auto const lexicon = testing::random_lexicon(160, length, 5);
+	auto const index = word_ladder::pattern_index(lexicon, length);
+	auto const landmarks = GENERATE(std::size_t{1}, std::size_t{4}, std::size_t{16});
+	auto const oracle = word_ladder::distance_oracle(index, landmarks);
+	CHECK(oracle.landmarks().size() <= landmarks);
+
+	auto exact = std::size_t{0};
+	auto disconnected = std::size_t{0};
+	for (auto a = word_ladder::word_id{0}; a < index.size(); a += 7) {
+		auto const expected = distances_from(index, a);
+		for (auto b = word_ladder::word_id{0}; b < index.size(); ++b) {
+			CAPTURE(landmarks, index.word(a), index.word(b));
+			auto const distance = expected[b];
+			CHECK(oracle.distance(a, b) == distance);
+			CHECK(oracle.lower_bound(a, b) <= distance);
+			CHECK(oracle.upper_bound(a, b) >= distance);
+			if (distance == unreachable) {
+				++disconnected;
+				CHECK(oracle.lower_bound(a, b) == unreachable);
+				CHECK(not oracle.distance(index.word(a), index.word(b)));
+			}
+			else {
+				if (oracle.lower_bound(a, b) == oracle.upper_bound(a, b)) {
+					++exact;
+				}
+				CHECK(oracle.distance(index.word(a), index.word(b)) == std::size_t{distance});
+			}
+		}
+	}
+	// Both the connected and the disconnected cases came up, and the bounds alone sometimes
+	// settled the distance
+	CHECK(disconnected > 0);
+	CHECK(exact > 0);
+
+	CHECK(not oracle.distance("zzzz", index.word(0)));
+	CHECK(not oracle.distance(index.word(0), "abc"));
+}
+
+TEST_CASE("component_sizes counts the words in each component") {
+	auto const length = std::size_t{4};
+	auto const lexicon = testing::random_lexicon(160, length, 5);
+	auto const index = word_ladder::pattern_index(lexicon, length);
+	auto const components = index.components();
+	auto const sizes = index.component_sizes();
+	REQUIRE(components.size() == index.size());
+
+	CHECK(std::accumulate(sizes.begin(), sizes.end(), std::size_t{0}) == index.size());
+	CHECK(sizes.size() > 1);
+	for (auto a = word_ladder::word_id{0}; a < index.size(); ++a) {
+		CAPTURE(index.word(a));
+		REQUIRE(components[a] < sizes.size());
+		auto const distances = distances_from(index, a);
+		auto const reached = std::count_if(distances.begin(), distances.end(), [](auto d) {
+			return d != unreachable;
+		});
+		CHECK(sizes[components[a]] == static_cast<std::uint32_t>(reached));
+		auto connected = std::vector<bool>(index.size());
+		auto expected = std::vector<bool>(index.size());
+		for (auto b = word_ladder::word_id{0}; b < index.size(); ++b) {
+			connected[b] = index.connected(a, b);
+			expected[b] = distances[b] != unreachable;
+		}
+		CHECK(connected == expected);
+	}
+}
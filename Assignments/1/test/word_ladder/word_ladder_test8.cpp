@@ -0,0 +1,104 @@
+#include "comp6771/search_stats.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "comp6771/pattern_index.hpp"
+#include "comp6771/solver.hpp"
+#include "comp6771/work_stealing_pool.hpp"
+#include "comp6771/word_ladder.hpp"
+#include "lexicons.hpp"
+
+using ladders_t = std::vector<std::vector<std::string>>;
+using word_ladder::search_mode;
+
+namespace {
+	auto total_expanded(word_ladder::search_stats const& stats) -> std::uint64_t {
+		return std::accumulate(stats.expanded.begin(), stats.expanded.end(), std::uint64_t{0});
+	}
+} // namespace
+
+TEST_CASE("Recording stats does not change the ladders") {
+	auto const lexicon = testing::small_lexicon();
+	auto const index = word_ladder::pattern_index(lexicon, 3);
+	auto const solver = word_ladder::solver(lexicon);
+	auto const mode = GENERATE(search_mode::forward, search_mode::bidirectional);
+	auto const expected = ladders_t{{"cat", "cot", "cog", "dog"}, {"cat", "cot", "dot", "dog"}};
+
+	SECTION("Over an index") {
+		auto stats = word_ladder::search_stats();
+		CHECK(word_ladder::generate("cat", "dog", index, mode, stats) == expected);
+		CHECK(word_ladder::generate("cat", "dog", index, mode) == expected);
+
+		CHECK(stats.queries == 1);
+		CHECK(stats.paths == 2);
+		CHECK(stats.probes > 0);
+		CHECK(stats.peak_frontier > 0);
+		// Every word expanded is one of the index's, and each shortest-path edge is recorded once
+		CHECK(total_expanded(stats) > 0);
+		CHECK(total_expanded(stats) <= index.word_count());
+		CHECK(stats.parent_links >= 3);
+
+		SECTION("A second search adds the same amounts again") {
+			auto const first = stats;
+			CHECK(word_ladder::generate("cat", "dog", index, mode, stats) == expected);
+			CHECK(stats.queries == 2 * first.queries);
+			CHECK(stats.probes == 2 * first.probes);
+			CHECK(stats.paths == 2 * first.paths);
+			CHECK(stats.parent_links == 2 * first.parent_links);
+			CHECK(total_expanded(stats) == 2 * total_expanded(first));
+			CHECK(stats.peak_frontier == first.peak_frontier);
+		}
+	}
+
+	SECTION("Through a solver") {
+		auto stats = word_ladder::search_stats();
+		CHECK(solver.generate("cat", "dog", mode, stats) == solver.generate("cat", "dog", mode));
+		CHECK(stats.queries == 1);
+		CHECK(stats.paths == 2);
+
+		// A query with no ladder still counts, and finds no paths
+		CHECK(solver.generate("cat", "cut", mode, stats).empty());
+		CHECK(solver.generate("cat", "zzz", mode, stats).empty());
+		CHECK(stats.queries == 3);
+		CHECK(stats.paths == 2);
+	}
+}
+
+TEST_CASE("A batch's stats are the total of its queries'") {
+	auto const length = std::size_t{4};
+	auto const lexicon = testing::random_lexicon(120, length, 4);
+	auto const solver = word_ladder::solver(lexicon);
+	auto const pairs = testing::some_pairs(lexicon, 8);
+	auto const mode = search_mode::bidirectional;
+
+	auto each = word_ladder::search_stats();
+	auto expected = std::vector<ladders_t>{};
+	for (auto const& [from, to] : pairs) {
+		auto one = word_ladder::search_stats();
+		expected.push_back(solver.generate(from, to, mode, one));
+		each += one;
+	}
+
+	auto pool = word_ladder::work_stealing_pool(3);
+	auto batch = word_ladder::search_stats();
+	CHECK(solver.generate_many(pairs, pool, mode, batch) == expected);
+	CHECK(solver.generate_many(pairs, pool, mode) == expected);
+
+	CHECK(batch.queries == pairs.size());
+	CHECK(batch.queries == each.queries);
+	CHECK(batch.probes == each.probes);
+	CHECK(batch.paths == each.paths);
+	CHECK(batch.parent_links == each.parent_links);
+	CHECK(batch.expanded == each.expanded);
+	CHECK(batch.peak_frontier == each.peak_frontier);
+	auto const ladders = std::accumulate(expected.begin(),
+	                                     expected.end(),
+	                                     std::uint64_t{0},
+	                                     [](auto n, auto const& l) { return n + l.size(); });
+	CHECK(batch.paths == ladders);
+}
@@ -4,7 +4,9 @@
 #include <__config>
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <compare>
+#include <concepts>
 #include <fmt/core.h>
 #include <fmt/format.h>
 #include <functional>
@@ -25,6 +27,9 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace comp6771 {
@@ -34,6 +39,182 @@ namespace comp6771 {
 		: std::runtime_error(what) {}
 	};
 
+	class euclidean_vector;
+
+	// A lazily evaluated element-wise expression over euclidean_vectors, such as (a + b) * 2.0 - c.
+	// Building one does no arithmetic and allocates nothing; element i is worked out only when
+	// asked for, so assigning the whole expression to a euclidean_vector runs a single fused loop
+	// straight into the destination. Dimension mismatches and division by zero still throw as soon
+	// as the expression is built. Every arithmetic operator below on euclidean_vectors builds one.
+	//
+	// Each operand is held as its storage type: a euclidean_vector named in the expression by
+	// reference, a temporary euclidean_vector or a nested expression by value, anything else that
+	// converts to a euclidean_vector as the vector it converts to, and a scalar as a double. An
+	// expression that refers to a named vector must not outlive it.
+	template<typename Op, typename... Operands>
+	class euclidean_expression;
+
+	namespace detail {
+		template<typename T>
+		struct is_expression : std::false_type {};
+		template<typename Op, typename... Operands>
+		struct is_expression<euclidean_expression<Op, Operands...>> : std::true_type {};
+		template<typename T>
+		inline constexpr auto is_expression_v = is_expression<std::remove_cvref_t<T>>::value;
+
+		// A euclidean_vector, or a class derived from one
+		template<typename T>
+		concept vector_type = std::derived_from<std::remove_cvref_t<T>, euclidean_vector>;
+
+		// Types whose number of dimensions is part of the type, such as fixed_euclidean_vector<N>,
+		// specialise this so arithmetic among themselves is left to their own operators, which check
+		// the dimensions at compile time
+		template<typename T>
+		inline constexpr auto has_static_dimensions = false;
+		template<typename T>
+		concept static_operand = has_static_dimensions<std::remove_cvref_t<T>>;
+
+		// Views onto magnitudes held somewhere else, such as the rows of a euclidean_vector_batch,
+		// specialise this to be held in expressions by value and read in place through their own
+		// dimensions() and operator[]
+		template<typename T>
+		inline constexpr auto is_view = false;
+		template<typename T>
+		concept view_operand = is_view<std::remove_cvref_t<T>>;
+
+		// Anything that converts implicitly to a euclidean_vector, including the expressions above
+		template<typename T>
+		concept operand = std::convertible_to<T, euclidean_vector>;
+
+		// A euclidean_vector named in an expression
+		struct vector_ref {
+			euclidean_vector const* v;
+		};
+
+		// How an expression stores each kind of operand
+		template<typename T>
+		using storage_t =
+		   std::conditional_t<is_expression_v<T> or view_operand<T>,
+		                      std::remove_cvref_t<T>,
+		                      std::conditional_t<vector_type<T> and std::is_lvalue_reference_v<T>,
+		                                         vector_ref,
+		                                         euclidean_vector>>;
+
+		// The magnitudes of a euclidean_vector. Up to inline_capacity of them are kept inside the
+		// object itself, so low-dimensional vectors never touch the allocator; more go on the heap.
+		class magnitude_buffer {
+		public:
+			static constexpr auto inline_capacity = std::size_t{8};
+
+			magnitude_buffer() noexcept = default;
+			// Room for size magnitudes, left uninitialised if they go on the heap
+			explicit magnitude_buffer(std::size_t size)
+			// NOLINTNEXTLINE(modernize-avoid-c-arrays)
+			: heap_(size > inline_capacity ? new double[size] : nullptr) {}
+			magnitude_buffer(magnitude_buffer&& other) noexcept
+			: heap_(std::move(other.heap_)) {
+				if (!heap_) {
+					inline_ = other.inline_;
+				}
+			}
+			auto operator=(magnitude_buffer&& other) noexcept -> magnitude_buffer& {
+				heap_ = std::move(other.heap_);
+				if (!heap_) {
+					inline_ = other.inline_;
+				}
+				return *this;
+			}
+			~magnitude_buffer() noexcept = default;
+
+			[[nodiscard]] auto get() noexcept -> double* {
+				return heap_ ? heap_.get() : inline_.data();
+			}
+			[[nodiscard]] auto get() const noexcept -> double const* {
+				return heap_ ? heap_.get() : inline_.data();
+			}
+			auto operator[](std::size_t i) noexcept -> double& {
+				return get()[i];
+			}
+			auto operator[](std::size_t i) const noexcept -> double {
+				return get()[i];
+			}
+
+		private:
+			std::array<double, inline_capacity> inline_ = {};
+			// NOLINTNEXTLINE(modernize-avoid-c-arrays)
+			std::unique_ptr<double[]> heap_;
+		};
+
+		// Element i of an operand, and its number of dimensions
+		constexpr auto element(double d, int) noexcept -> double {
+			return d;
+		}
+		inline auto element(euclidean_vector const& v, int i) noexcept -> double;
+		inline auto element(vector_ref r, int i) noexcept -> double;
+		template<typename Op, typename... Operands>
+		auto element(euclidean_expression<Op, Operands...> const& e, int i) noexcept -> double {
+			return e[i];
+		}
+		template<view_operand V>
+		auto element(V const& v, int i) noexcept -> double {
+			return v[i];
+		}
+
+		inline auto dimensions(euclidean_vector const& v) noexcept -> int;
+		inline auto dimensions(vector_ref r) noexcept -> int;
+
+		// out[i] = x[i] op y[i] (or op d) for i < n, using the widest vector instructions this CPU
+		// has. out may be x or y.
+		auto add(double* out, double const* x, double const* y, std::size_t n) noexcept -> void;
+		auto subtract(double* out, double const* x, double const* y, std::size_t n) noexcept -> void;
+		auto multiply(double* out, double const* x, double d, std::size_t n) noexcept -> void;
+		auto divide(double* out, double const* x, double d, std::size_t n) noexcept -> void;
+
+		// Evaluates e into out with one of the kernels above if it is a single operation on whole
+		// vectors, such as a + b or a * 2.0. Returns false, having done nothing, otherwise.
+		template<typename Op, typename... Operands>
+		auto vectorised(double* out, euclidean_expression<Op, Operands...> const& e) noexcept -> bool;
+		template<typename Op, typename... Operands>
+		auto dimensions(euclidean_expression<Op, Operands...> const& e) noexcept -> int {
+			return e.dimensions();
+		}
+		template<view_operand V>
+		auto dimensions(V const& v) noexcept -> int {
+			return v.dimensions();
+		}
+	} // namespace detail
+
+	template<typename Op, typename... Operands>
+	class euclidean_expression {
+	public:
+		euclidean_expression(int dimension, Operands... operands)
+		: dimension_(dimension)
+		, operands_(std::move(operands)...) {}
+
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return dimension_;
+		}
+
+		[[nodiscard]] auto operands() const noexcept -> std::tuple<Operands...> const& {
+			return operands_;
+		}
+
+		// Pre: 0 <= i < dimensions()
+		auto operator[](int i) const noexcept -> double {
+			return std::apply(
+			   [i](auto const&... operand) { return Op{}(detail::element(operand, i)...); },
+			   operands_);
+		}
+
+		// The euclidean_vector this expression evaluates to, which owns its magnitudes and so
+		// outlives the operands
+		[[nodiscard]] auto eval() const -> euclidean_vector;
+
+	private:
+		int dimension_;
+		std::tuple<Operands...> operands_;
+	};
+
 	class euclidean_vector {
 	public:
 		// --------- Part1: Constructors ---------
@@ -45,6 +226,16 @@ namespace comp6771 {
 		euclidean_vector(std::initializer_list<double>) noexcept;
 		euclidean_vector(euclidean_vector const&) noexcept;
 		euclidean_vector(euclidean_vector&&) noexcept;
+		// Evaluates the expression in one pass over memory. Implicit, so an expression can be used
+		// wherever a euclidean_vector is expected.
+		template<typename Op, typename... Operands>
+		// NOLINTNEXTLINE(google-explicit-constructor)
+		euclidean_vector(euclidean_expression<Op, Operands...> const& e) noexcept
+		: dimension_(e.dimensions())
+		, magnitudes_(static_cast<std::size_t>(e.dimensions()))
+		, cache_(-1) {
+			evaluate(e);
+		}
 
 		// --------- Part2: Deconstructor ---------
 		~euclidean_vector() noexcept = default;
@@ -52,6 +243,18 @@ namespace comp6771 {
 		// --------- Part3: Operations ---------
 		auto operator=(euclidean_vector const&) noexcept -> euclidean_vector&; // Copy Assignment
 		auto operator=(euclidean_vector&&) noexcept -> euclidean_vector&; // Move Assignment
+		// Evaluates the expression straight into this vector, reusing its storage when the
+		// dimensions already match. The expression may refer to this vector.
+		template<typename Op, typename... Operands>
+		auto operator=(euclidean_expression<Op, Operands...> const& e) noexcept -> euclidean_vector& {
+			if (e.dimensions() != dimension_) {
+				*this = euclidean_vector(e);
+				return *this;
+			}
+			evaluate(e);
+			cache_ = -1;
+			return *this;
+		}
 
 		auto operator[](int) const noexcept -> double; // Subscript: const
 		auto operator[](int) noexcept -> double&; // Subscript
@@ -61,18 +264,30 @@ namespace comp6771 {
 			euclidean_vector v{cur};
 			return v;
 		}
-		// Negation
-		friend auto operator-(const euclidean_vector& cur) noexcept -> euclidean_vector {
-			euclidean_vector v{cur};
-			std::transform(v.magnitudes_.get(),
-			               v.magnitudes_.get() + v.dimension_,
-			               v.magnitudes_.get(),
-			               std::negate());
-			return v;
-		}
 
 		auto operator+=(const euclidean_vector&) -> euclidean_vector&; // Compound Addition
 		auto operator-=(const euclidean_vector&) -> euclidean_vector&; // Compound Subtraction
+		// As above, adding each element of the expression in place as it is worked out
+		template<typename Op, typename... Operands>
+		auto operator+=(euclidean_expression<Op, Operands...> const& e) -> euclidean_vector& {
+			check_dimensions(e.dimensions());
+			auto* const out = magnitudes_.get();
+			for (auto i = 0; i < dimension_; ++i) {
+				out[i] += e[i];
+			}
+			cache_ = -1;
+			return *this;
+		}
+		template<typename Op, typename... Operands>
+		auto operator-=(euclidean_expression<Op, Operands...> const& e) -> euclidean_vector& {
+			check_dimensions(e.dimensions());
+			auto* const out = magnitudes_.get();
+			for (auto i = 0; i < dimension_; ++i) {
+				out[i] -= e[i];
+			}
+			cache_ = -1;
+			return *this;
+		}
 
 		auto operator*=(double) noexcept -> euclidean_vector&; // Compound Multiplication
 		auto operator/=(double) -> euclidean_vector&; // Compound Division
@@ -108,47 +323,6 @@ namespace comp6771 {
 		   -> bool {
 			return !(v1 == v2);
 		}
-		friend auto operator+(euclidean_vector const& v1, euclidean_vector const& v2)
-		   -> euclidean_vector {
-			if (v1.dimension_ != v2.dimension_) {
-				auto e = std::stringstream();
-				e << "Dimensions of LHS(" << v1.dimension_ << ") and RHS(" << v2.dimension_
-				  << ") do not match";
-				throw euclidean_vector_error(e.str());
-			}
-			euclidean_vector res{v1};
-			res += v2;
-			return res;
-		}
-		friend auto operator-(euclidean_vector const& v1, euclidean_vector const& v2)
-		   -> euclidean_vector {
-			if (v1.dimension_ != v2.dimension_) {
-				auto e = std::stringstream();
-				e << "Dimensions of LHS(" << v1.dimension_ << ") and RHS(" << v2.dimension_
-				  << ") do not match";
-				throw euclidean_vector_error(e.str());
-			}
-			euclidean_vector res{v1};
-			res -= v2;
-			return res;
-		}
-
-		// Should implement U * T and T * U
-		friend auto operator*(euclidean_vector const& v, double d) noexcept -> euclidean_vector {
-			euclidean_vector res{v};
-			return res *= d;
-		}
-		friend auto operator*(double d, euclidean_vector const& v) noexcept -> euclidean_vector {
-			euclidean_vector res{v};
-			return res *= d;
-		}
-		friend auto operator/(euclidean_vector const& v, double d) -> euclidean_vector {
-			if (d == 0) {
-				throw euclidean_vector_error("Invalid vector division by 0");
-			}
-			euclidean_vector res{v};
-			return res /= d;
-		}
 		friend auto operator<<(std::ostream& out, euclidean_vector const& v) -> std::ostream& {
 			// auto const vectorized = std::vector<double>(v);
 			// std::ostringstream os;
@@ -169,7 +343,8 @@ namespace comp6771 {
 			out << '[';
 			auto i = 0;
 			auto const span_v =
-			   std::span<double>(v.magnitudes_.get(), gsl::narrow_cast<std::size_t>(v.dimension_));
+			   std::span<double const>(v.magnitudes_.get(),
+			                           gsl::narrow_cast<std::size_t>(v.dimension_));
 			ranges::for_each (span_v, [&i, &out, &v](auto const& mag) {
 				out << mag;
 				if (i != v.dimension_ - 1) {
@@ -196,13 +371,235 @@ namespace comp6771 {
 		};
 
 	private:
+		// Throws if an operand with this many dimensions cannot be combined with this vector
+		auto check_dimensions(int dimension) const -> void;
+
+		template<typename Op, typename... Operands>
+		auto evaluate(euclidean_expression<Op, Operands...> const& e) noexcept -> void {
+			auto* const out = magnitudes_.get();
+			if (detail::vectorised(out, e)) {
+				return;
+			}
+			for (auto i = 0; i < dimension_; ++i) {
+				out[i] = e[i];
+			}
+		}
+
 		int dimension_;
-		// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-		std::unique_ptr<double[]> magnitudes_;
+		detail::magnitude_buffer magnitudes_;
 		// TODO (add cache_ for every constructor)
 		mutable double cache_;
 	};
 
+	template<typename Op, typename... Operands>
+	auto euclidean_expression<Op, Operands...>::eval() const -> euclidean_vector {
+		return euclidean_vector(*this);
+	}
+
+	namespace detail {
+		inline auto element(euclidean_vector const& v, int i) noexcept -> double {
+			return v.begin()[i];
+		}
+		inline auto element(vector_ref r, int i) noexcept -> double {
+			return r.v->begin()[i];
+		}
+		inline auto dimensions(euclidean_vector const& v) noexcept -> int {
+			return v.dimensions();
+		}
+		inline auto dimensions(vector_ref r) noexcept -> int {
+			return r.v->dimensions();
+		}
+
+		// A whole vector held in an expression, and where its magnitudes start
+		template<typename T>
+		inline constexpr auto is_leaf_v =
+		   std::same_as<T, vector_ref> or std::same_as<T, euclidean_vector>;
+		inline auto data(euclidean_vector const& v) noexcept -> double const* {
+			return v.begin();
+		}
+		inline auto data(vector_ref r) noexcept -> double const* {
+			return r.v->begin();
+		}
+
+		template<typename Op, typename... Operands>
+		auto vectorised(double* out, euclidean_expression<Op, Operands...> const& e) noexcept
+		   -> bool {
+			auto const n = static_cast<std::size_t>(e.dimensions());
+			auto const& operands = e.operands();
+			if constexpr (sizeof...(Operands) == 1) {
+				if constexpr (std::same_as<Op, std::negate<>> and is_leaf_v<Operands...>) {
+					multiply(out, data(std::get<0>(operands)), -1.0, n);
+					return true;
+				}
+			}
+			else if constexpr (sizeof...(Operands) == 2) {
+				using x = std::tuple_element_t<0, std::tuple<Operands...>>;
+				using y = std::tuple_element_t<1, std::tuple<Operands...>>;
+				if constexpr (is_leaf_v<x> and is_leaf_v<y>) {
+					if constexpr (std::same_as<Op, std::plus<>>) {
+						add(out, data(std::get<0>(operands)), data(std::get<1>(operands)), n);
+						return true;
+					}
+					else if constexpr (std::same_as<Op, std::minus<>>) {
+						subtract(out, data(std::get<0>(operands)), data(std::get<1>(operands)), n);
+						return true;
+					}
+				}
+				else if constexpr (is_leaf_v<x> and std::same_as<y, double>) {
+					if constexpr (std::same_as<Op, std::multiplies<>>) {
+						multiply(out, data(std::get<0>(operands)), std::get<1>(operands), n);
+						return true;
+					}
+					else if constexpr (std::same_as<Op, std::divides<>>) {
+						divide(out, data(std::get<0>(operands)), std::get<1>(operands), n);
+						return true;
+					}
+				}
+				else if constexpr (std::same_as<x, double> and is_leaf_v<y>) {
+					if constexpr (std::same_as<Op, std::multiplies<>>) {
+						multiply(out, data(std::get<1>(operands)), std::get<0>(operands), n);
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+
+		// Wraps an operand in its storage type
+		template<typename T>
+		auto hold(T&& operand) -> storage_t<T> {
+			if constexpr (std::same_as<storage_t<T>, vector_ref>) {
+				return vector_ref{&operand};
+			}
+			else {
+				return storage_t<T>(std::forward<T>(operand));
+			}
+		}
+
+		// An operand as something element() and dimensions() can read: itself if it is a vector, an
+		// expression or a view, or else the euclidean_vector it converts to
+		template<typename T>
+		auto readable(T const& operand) -> decltype(auto) {
+			if constexpr (vector_type<T>) {
+				return static_cast<euclidean_vector const&>(operand);
+			}
+			else if constexpr (is_expression_v<T> or view_operand<T>) {
+				return (operand);
+			}
+			else {
+				return euclidean_vector(operand);
+			}
+		}
+
+		template<typename L, typename R>
+		auto matching_dimensions(L const& lhs, R const& rhs) -> int {
+			if (dimensions(lhs) != dimensions(rhs)) {
+				auto e = std::stringstream();
+				e << "Dimensions of LHS(" << dimensions(lhs) << ") and RHS(" << dimensions(rhs)
+				  << ") do not match";
+				throw euclidean_vector_error(e.str());
+			}
+			return dimensions(lhs);
+		}
+	} // namespace detail
+
+	// ---------- Part5: Arithmetic ----------
+	// Each operator checks its operands and returns a euclidean_expression; no arithmetic is done
+	// until the expression is assigned or read, so a whole chain such as a + b * 2.0 - c is
+	// evaluated in one pass over memory, straight into the vector it is assigned to. The expression
+	// refers to the named vectors in it, so `auto e = a + b;` reads a and b when e is evaluated, not
+	// when it is built, and must not outlive them. To keep the result instead, give it a vector
+	// type, as in `euclidean_vector c = a + b;`, or call `(a + b).eval()`.
+	template<detail::operand L, detail::operand R>
+	requires(not(detail::static_operand<L> and detail::static_operand<R>))
+	auto operator+(L&& lhs, R&& rhs) {
+		auto l = detail::hold(std::forward<L>(lhs));
+		auto r = detail::hold(std::forward<R>(rhs));
+		auto const dimension = detail::matching_dimensions(l, r);
+		return euclidean_expression<std::plus<>, detail::storage_t<L>, detail::storage_t<R>>(
+		   dimension, std::move(l), std::move(r));
+	}
+	template<detail::operand L, detail::operand R>
+	requires(not(detail::static_operand<L> and detail::static_operand<R>))
+	auto operator-(L&& lhs, R&& rhs) {
+		auto l = detail::hold(std::forward<L>(lhs));
+		auto r = detail::hold(std::forward<R>(rhs));
+		auto const dimension = detail::matching_dimensions(l, r);
+		return euclidean_expression<std::minus<>, detail::storage_t<L>, detail::storage_t<R>>(
+		   dimension, std::move(l), std::move(r));
+	}
+	// Negation
+	template<detail::operand E>
+	requires(not detail::static_operand<E>)
+	auto operator-(E&& e) {
+		auto held = detail::hold(std::forward<E>(e));
+		auto const dimension = detail::dimensions(held);
+		return euclidean_expression<std::negate<>, detail::storage_t<E>>(dimension, std::move(held));
+	}
+	// Should implement U * T and T * U
+	template<detail::operand E>
+	requires(not detail::static_operand<E>)
+	auto operator*(E&& e, double d) {
+		auto held = detail::hold(std::forward<E>(e));
+		auto const dimension = detail::dimensions(held);
+		return euclidean_expression<std::multiplies<>, detail::storage_t<E>, double>(
+		   dimension, std::move(held), d);
+	}
+	template<detail::operand E>
+	requires(not detail::static_operand<E>)
+	auto operator*(double d, E&& e) {
+		auto held = detail::hold(std::forward<E>(e));
+		auto const dimension = detail::dimensions(held);
+		return euclidean_expression<std::multiplies<>, double, detail::storage_t<E>>(
+		   dimension, d, std::move(held));
+	}
+	template<detail::operand E>
+	requires(not detail::static_operand<E>)
+	auto operator/(E&& e, double d) {
+		if (d == 0) {
+			throw euclidean_vector_error("Invalid vector division by 0");
+		}
+		auto held = detail::hold(std::forward<E>(e));
+		auto const dimension = detail::dimensions(held);
+		return euclidean_expression<std::divides<>, detail::storage_t<E>, double>(
+		   dimension, std::move(held), d);
+	}
+
+	// Comparing or printing an expression reads its elements as it goes, without a vector to hold
+	// them
+	template<detail::operand L, detail::operand R>
+	requires(detail::is_expression_v<L> or detail::is_expression_v<R>)
+	auto operator==(L const& lhs, R const& rhs) -> bool {
+		auto const& l = detail::readable(lhs);
+		auto const& r = detail::readable(rhs);
+		if (detail::dimensions(l) != detail::dimensions(r)) {
+			return false;
+		}
+		for (auto i = 0; i < detail::dimensions(l); ++i) {
+			if (std::fabs(detail::element(l, i) - detail::element(r, i)) > 1e-14) {
+				return false;
+			}
+		}
+		return true;
+	}
+	template<detail::operand L, detail::operand R>
+	requires(detail::is_expression_v<L> or detail::is_expression_v<R>)
+	auto operator!=(L const& lhs, R const& rhs) -> bool {
+		return !(lhs == rhs);
+	}
+	template<typename Op, typename... Operands>
+	auto operator<<(std::ostream& out, euclidean_expression<Op, Operands...> const& e)
+	   -> std::ostream& {
+		out << '[';
+		for (auto i = 0; i < e.dimensions(); ++i) {
+			out << e[i];
+			if (i != e.dimensions() - 1) {
+				out << ' ';
+			}
+		}
+		return out << ']';
+	}
+
 	// ---------- Part6: Utility functions ---------
 	// To avoid hidden friends
 	auto euclidean_norm(euclidean_vector const& ev) -> double;
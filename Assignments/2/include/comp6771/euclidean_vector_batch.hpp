@@ -0,0 +1,188 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_BATCH_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_BATCH_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <span>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+namespace comp6771 {
+	// One vector in a euclidean_vector_batch. T is double for a row that can be written through
+	// and double const for one that cannot. A row refers into its batch and must not outlive it.
+	// Rows take part in euclidean_vector arithmetic directly: row + v * 2.0 gives an expression
+	// that reads the row in place when it is evaluated.
+	template<typename T>
+	class euclidean_vector_row {
+	public:
+		euclidean_vector_row(T* first, std::size_t stride, int dimension) noexcept
+		: first_(first)
+		, stride_(stride)
+		, dimension_(dimension) {}
+		euclidean_vector_row(euclidean_vector_row const&) noexcept = default;
+		~euclidean_vector_row() noexcept = default;
+		// A writable row can be read as a read-only one
+		// NOLINTNEXTLINE(google-explicit-constructor)
+		operator euclidean_vector_row<double const>() const noexcept
+		requires(not std::is_const_v<T>)
+		{
+			return {first_, stride_, dimension_};
+		}
+
+		// Assigning to a row copies magnitudes into the batch; it never rebinds the row
+		auto operator=(euclidean_vector_row const& r) const -> euclidean_vector_row const&
+		requires(not std::is_const_v<T>)
+		{
+			return *this = euclidean_vector(r);
+		}
+		auto operator=(euclidean_vector const& v) const -> euclidean_vector_row const&
+		requires(not std::is_const_v<T>)
+		{
+			if (v.dimensions() != dimension_) {
+				auto e = std::stringstream();
+				e << "Dimensions of LHS(" << dimension_ << ") and RHS(" << v.dimensions()
+				  << ") do not match";
+				throw euclidean_vector_error(e.str());
+			}
+			for (auto j = 0; j < dimension_; ++j) {
+				(*this)[j] = v[j];
+			}
+			return *this;
+		}
+
+		// Evaluates the expression straight into the row. The expression may refer to this row.
+		template<typename Op, typename... Operands>
+		auto operator=(euclidean_expression<Op, Operands...> const& e) const
+		   -> euclidean_vector_row const&
+		requires(not std::is_const_v<T>)
+		{
+			if (e.dimensions() != dimension_) {
+				auto ex = std::stringstream();
+				ex << "Dimensions of LHS(" << dimension_ << ") and RHS(" << e.dimensions()
+				   << ") do not match";
+				throw euclidean_vector_error(ex.str());
+			}
+			for (auto j = 0; j < dimension_; ++j) {
+				(*this)[j] = e[j];
+			}
+			return *this;
+		}
+
+		// Pre: 0 <= j < dimensions()
+		auto operator[](int j) const noexcept -> T& {
+			return first_[static_cast<std::size_t>(j) * stride_];
+		}
+		[[nodiscard]] auto at(int j) const -> T& {
+			if (j < 0 || j >= dimension_) {
+				auto e = std::stringstream();
+				e << "Index " << j << " is not valid for this euclidean_vector object";
+				throw euclidean_vector_error(e.str());
+			}
+			return (*this)[j];
+		}
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return dimension_;
+		}
+
+		// Copies the row out, so it can be passed to anything that takes a euclidean_vector
+		// NOLINTNEXTLINE(google-explicit-constructor)
+		operator euclidean_vector() const {
+			auto v = euclidean_vector(dimension_);
+			for (auto j = 0; j < dimension_; ++j) {
+				v[j] = (*this)[j];
+			}
+			return v;
+		}
+
+		friend auto operator==(euclidean_vector_row const& r, euclidean_vector const& v) -> bool {
+			return euclidean_vector(r) == v;
+		}
+		friend auto operator<<(std::ostream& out, euclidean_vector_row const& r) -> std::ostream& {
+			return out << euclidean_vector(r);
+		}
+
+	private:
+		T* first_;
+		std::size_t stride_;
+		int dimension_;
+	};
+
+	namespace detail {
+		template<typename T>
+		inline constexpr auto is_view<euclidean_vector_row<T>> = true;
+	} // namespace detail
+
+	// size() vectors with the same number of dimensions, held in one allocation rather than one
+	// each. The storage is laid out as a structure of arrays: magnitude j of every vector sits in
+	// one contiguous column, and each column starts on a cache-line boundary. The batched dot,
+	// euclidean_norm and unit below run down those columns, working on every vector at once.
+	class euclidean_vector_batch {
+	public:
+		// Columns start on, and are padded to, this many bytes
+		static constexpr auto alignment = std::size_t{64};
+
+		// size vectors with dimension magnitudes each, all zero
+		euclidean_vector_batch(std::size_t size, int dimension);
+		// A copy of each of vectors, which must all have the same number of dimensions
+		explicit euclidean_vector_batch(std::span<euclidean_vector const> vectors);
+		euclidean_vector_batch(euclidean_vector_batch const&);
+		euclidean_vector_batch(euclidean_vector_batch&&) noexcept;
+		auto operator=(euclidean_vector_batch const&) -> euclidean_vector_batch&;
+		auto operator=(euclidean_vector_batch&&) noexcept -> euclidean_vector_batch&;
+		~euclidean_vector_batch() noexcept = default;
+
+		// Pre: i < size()
+		auto operator[](std::size_t i) noexcept -> euclidean_vector_row<double> {
+			return {data_.get() + i, stride_, dimension_};
+		}
+		auto operator[](std::size_t i) const noexcept -> euclidean_vector_row<double const> {
+			return {data_.get() + i, stride_, dimension_};
+		}
+		[[nodiscard]] auto at(std::size_t i) -> euclidean_vector_row<double>;
+		[[nodiscard]] auto at(std::size_t i) const -> euclidean_vector_row<double const>;
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return size_;
+		}
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return dimension_;
+		}
+
+		// Magnitude j of every vector in the batch. Pre: 0 <= j < dimensions()
+		[[nodiscard]] auto column(int j) noexcept -> std::span<double> {
+			return {data_.get() + static_cast<std::size_t>(j) * stride_, size_};
+		}
+		[[nodiscard]] auto column(int j) const noexcept -> std::span<double const> {
+			return {data_.get() + static_cast<std::size_t>(j) * stride_, size_};
+		}
+
+	private:
+		struct aligned_delete {
+			auto operator()(double* p) const noexcept -> void {
+				::operator delete[](p, std::align_val_t{alignment});
+			}
+		};
+
+		std::size_t size_;
+		int dimension_;
+		// Distance between the starts of two columns, in doubles
+		std::size_t stride_;
+		// NOLINTNEXTLINE(modernize-avoid-c-arrays)
+		std::unique_ptr<double[], aligned_delete> data_;
+	};
+
+	// The dot product of each vector in a with the vector at the same index in b
+	auto dot(euclidean_vector_batch const& a, euclidean_vector_batch const& b)
+	   -> std::vector<double>;
+	// The euclidean norm of every vector in the batch
+	auto euclidean_norm(euclidean_vector_batch const& batch) -> std::vector<double>;
+	// The unit vector of every vector in the batch
+	auto unit(euclidean_vector_batch const& batch) -> euclidean_vector_batch;
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_BATCH_HPP
@@ -0,0 +1,215 @@
+#ifndef COMP6771_FIXED_EUCLIDEAN_VECTOR_HPP
+#define COMP6771_FIXED_EUCLIDEAN_VECTOR_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <ostream>
+#include <sstream>
+#include <utility>
+
+namespace comp6771 {
+	// A euclidean_vector whose number of dimensions is fixed at compile time. Its magnitudes are an
+	// std::array held in the object, every operation is unrolled over the N elements and can run in
+	// a constant expression, and combining vectors of different dimensions does not compile.
+	//
+	// It converts implicitly to a euclidean_vector, so it can be passed to anything that takes one,
+	// and explicitly back from one, which throws if the dimensions do not match. Arithmetic with a
+	// euclidean_vector on the other side, such as fixed + dynamic, goes through euclidean_vector's
+	// operators, which check the dimensions at run time.
+	template<std::size_t N>
+	class fixed_euclidean_vector {
+	public:
+		// --------- Part1: Constructors ---------
+		constexpr fixed_euclidean_vector() noexcept = default;
+		constexpr explicit fixed_euclidean_vector(double magnitude) noexcept {
+			apply([this, magnitude](std::size_t i) { magnitudes_[i] = magnitude; });
+		}
+		// Exactly N magnitudes
+		template<std::convertible_to<double>... Magnitudes>
+		requires(sizeof...(Magnitudes) == N and N > 1)
+		constexpr fixed_euclidean_vector(Magnitudes... magnitudes) noexcept
+		: magnitudes_{static_cast<double>(magnitudes)...} {}
+		constexpr explicit fixed_euclidean_vector(std::array<double, N> const& magnitudes) noexcept
+		: magnitudes_(magnitudes) {}
+		explicit fixed_euclidean_vector(euclidean_vector const& v) {
+			if (v.dimensions() != static_cast<int>(N)) {
+				auto e = std::stringstream();
+				e << "Dimensions of LHS(" << N << ") and RHS(" << v.dimensions() << ") do not match";
+				throw euclidean_vector_error(e.str());
+			}
+			apply([this, &v](std::size_t i) { magnitudes_[i] = v[static_cast<int>(i)]; });
+		}
+
+		// --------- Part3: Operations ---------
+		constexpr auto operator[](std::size_t i) const noexcept -> double {
+			return magnitudes_[i];
+		}
+		constexpr auto operator[](std::size_t i) noexcept -> double& {
+			return magnitudes_[i];
+		}
+
+		constexpr auto operator+=(fixed_euclidean_vector const& v) noexcept
+		   -> fixed_euclidean_vector& {
+			apply([this, &v](std::size_t i) { magnitudes_[i] += v.magnitudes_[i]; });
+			return *this;
+		}
+		constexpr auto operator-=(fixed_euclidean_vector const& v) noexcept
+		   -> fixed_euclidean_vector& {
+			apply([this, &v](std::size_t i) { magnitudes_[i] -= v.magnitudes_[i]; });
+			return *this;
+		}
+		constexpr auto operator*=(double d) noexcept -> fixed_euclidean_vector& {
+			apply([this, d](std::size_t i) { magnitudes_[i] *= d; });
+			return *this;
+		}
+		constexpr auto operator/=(double d) -> fixed_euclidean_vector& {
+			if (d == 0) {
+				throw euclidean_vector_error("Invalid vector division by 0");
+			}
+			apply([this, d](std::size_t i) { magnitudes_[i] /= d; });
+			return *this;
+		}
+
+		// Widening to the dynamic type loses nothing, so it is implicit
+		// NOLINTNEXTLINE(google-explicit-constructor)
+		operator euclidean_vector() const {
+			auto v = euclidean_vector(static_cast<int>(N));
+			apply([&v, this](std::size_t i) { v[static_cast<int>(i)] = magnitudes_[i]; });
+			return v;
+		}
+		constexpr explicit operator std::array<double, N>() const noexcept {
+			return magnitudes_;
+		}
+
+		// --------- Part4: Member Functions ---------
+		[[nodiscard]] constexpr auto at(std::size_t i) const -> double {
+			check(i);
+			return magnitudes_[i];
+		}
+		[[nodiscard]] constexpr auto at(std::size_t i) -> double& {
+			check(i);
+			return magnitudes_[i];
+		}
+		[[nodiscard]] static constexpr auto dimensions() noexcept -> int {
+			return static_cast<int>(N);
+		}
+
+		[[nodiscard]] constexpr auto begin() const noexcept -> double const* {
+			return magnitudes_.data();
+		}
+		[[nodiscard]] constexpr auto end() const noexcept -> double const* {
+			return magnitudes_.data() + N;
+		}
+
+		// --------- Part5: Friends ----------
+		friend constexpr auto
+		operator==(fixed_euclidean_vector const& v1, fixed_euclidean_vector const& v2) noexcept
+		   -> bool {
+			return [&]<std::size_t... I>(std::index_sequence<I...>) {
+				return (... and close(v1.magnitudes_[I], v2.magnitudes_[I]));
+			}(std::make_index_sequence<N>{});
+		}
+		friend constexpr auto
+		operator+(fixed_euclidean_vector v1, fixed_euclidean_vector const& v2) noexcept
+		   -> fixed_euclidean_vector {
+			return v1 += v2;
+		}
+		friend constexpr auto
+		operator-(fixed_euclidean_vector v1, fixed_euclidean_vector const& v2) noexcept
+		   -> fixed_euclidean_vector {
+			return v1 -= v2;
+		}
+		friend constexpr auto operator-(fixed_euclidean_vector v) noexcept -> fixed_euclidean_vector {
+			return v *= -1.0;
+		}
+		friend constexpr auto operator*(fixed_euclidean_vector v, double d) noexcept
+		   -> fixed_euclidean_vector {
+			return v *= d;
+		}
+		friend constexpr auto operator*(double d, fixed_euclidean_vector v) noexcept
+		   -> fixed_euclidean_vector {
+			return v *= d;
+		}
+		friend constexpr auto operator/(fixed_euclidean_vector v, double d)
+		   -> fixed_euclidean_vector {
+			return v /= d;
+		}
+		friend auto operator<<(std::ostream& out, fixed_euclidean_vector const& v) -> std::ostream& {
+			out << '[';
+			for (auto i = std::size_t{0}; i < N; ++i) {
+				out << v.magnitudes_[i];
+				if (i != N - 1) {
+					out << ' ';
+				}
+			}
+			return out << ']';
+		}
+
+	private:
+		// Calls f(0), f(1), ..., f(N - 1), spelled out rather than looped
+		template<typename F>
+		static constexpr auto apply(F f) noexcept(noexcept(f(std::size_t{0}))) -> void {
+			[&f]<std::size_t... I>(std::index_sequence<I...>) {
+				(f(I), ...);
+			}(std::make_index_sequence<N>{});
+		}
+
+		// Within the same tolerance euclidean_vector compares with. std::fabs is not constexpr.
+		static constexpr auto close(double x, double y) noexcept -> bool {
+			return x - y <= 1e-14 and y - x <= 1e-14;
+		}
+
+		static constexpr auto check(std::size_t i) -> void {
+			if (i >= N) {
+				auto e = std::stringstream();
+				e << "Index " << i << " is not valid for this euclidean_vector object";
+				throw euclidean_vector_error(e.str());
+			}
+		}
+
+		std::array<double, N> magnitudes_ = {};
+	};
+
+	namespace detail {
+		template<std::size_t N>
+		inline constexpr auto has_static_dimensions<fixed_euclidean_vector<N>> = true;
+	} // namespace detail
+
+	// Deduces the dimension from the number of magnitudes
+	template<std::convertible_to<double>... Magnitudes>
+	fixed_euclidean_vector(Magnitudes...) -> fixed_euclidean_vector<sizeof...(Magnitudes)>;
+
+	// ---------- Part6: Utility functions ---------
+	// The dot product of two vectors of the same dimension
+	template<std::size_t N>
+	constexpr auto
+	dot(fixed_euclidean_vector<N> const& a, fixed_euclidean_vector<N> const& b) noexcept -> double {
+		return [&]<std::size_t... I>(std::index_sequence<I...>) {
+			return (0.0 + ... + (a[I] * b[I]));
+		}(std::make_index_sequence<N>{});
+	}
+	// Square root of the sum of the squares of the magnitudes. A vector with no dimensions has no
+	// norm, so it does not compile.
+	template<std::size_t N>
+	requires(N > 0)
+	auto euclidean_norm(fixed_euclidean_vector<N> const& v) noexcept -> double {
+		return std::sqrt(dot(v, v));
+	}
+	// Unit vector of v
+	template<std::size_t N>
+	requires(N > 0)
+	auto unit(fixed_euclidean_vector<N> const& v) -> fixed_euclidean_vector<N> {
+		auto const norm = euclidean_norm(v);
+		if (norm == 0) {
+			throw euclidean_vector_error("euclidean_vector with zero euclidean normal does not have a "
+			                             "unit vector");
+		}
+		return v / norm;
+	}
+} // namespace comp6771
+
+#endif // COMP6771_FIXED_EUCLIDEAN_VECTOR_HPP
@@ -2,40 +2,347 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 //
 #include "comp6771/euclidean_vector.hpp"
+#include <array>
 #include <cstddef>
 #include <exception>
 #include <functional>
 #include <initializer_list>
 #include <iostream>
 #include <memory>
-#include <numeric>
 #include <range/v3/functional.hpp>
 #include <utility>
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define COMP6771_EUCLIDEAN_VECTOR_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
 using gsl_lite::narrow_cast;
 namespace comp6771 {
+	namespace {
+		// The element-wise kernels behind the arithmetic operators, dot and euclidean_norm. There is
+		// one set per instruction set; the widest one this CPU supports is picked on first use.
+		// Every set computes +, -, * and / element by element exactly as the scalar loop does; only
+		// the sums in dot may round differently, since they are added up in a different order.
+		struct kernels {
+			void (*add)(double*, double const*, double const*, std::size_t);
+			void (*subtract)(double*, double const*, double const*, std::size_t);
+			void (*multiply)(double*, double const*, double, std::size_t);
+			void (*divide)(double*, double const*, double, std::size_t);
+			double (*dot)(double const*, double const*, std::size_t);
+		};
+
+		// Each of add, subtract, multiply and divide sets out[i] = x[i] op y[i] (or op d) for i < n.
+		// out may be x or y: every lane is loaded before it is stored.
+
+		// Portable loops, written plainly enough for the compiler to vectorise for the baseline ISA
+		namespace portable {
+			auto add(double* out, double const* x, double const* y, std::size_t n) -> void {
+				for (auto i = std::size_t{0}; i < n; ++i) {
+					out[i] = x[i] + y[i];
+				}
+			}
+			auto subtract(double* out, double const* x, double const* y, std::size_t n) -> void {
+				for (auto i = std::size_t{0}; i < n; ++i) {
+					out[i] = x[i] - y[i];
+				}
+			}
+			auto multiply(double* out, double const* x, double d, std::size_t n) -> void {
+				for (auto i = std::size_t{0}; i < n; ++i) {
+					out[i] = x[i] * d;
+				}
+			}
+			auto divide(double* out, double const* x, double d, std::size_t n) -> void {
+				for (auto i = std::size_t{0}; i < n; ++i) {
+					out[i] = x[i] / d;
+				}
+			}
+			auto dot(double const* x, double const* y, std::size_t n) -> double {
+				// Four running sums, so consecutive multiply-adds do not wait on each other
+				auto sums = std::array<double, 4>{};
+				auto i = std::size_t{0};
+				for (; i + 4 <= n; i += 4) {
+					sums[0] += x[i] * y[i];
+					sums[1] += x[i + 1] * y[i + 1];
+					sums[2] += x[i + 2] * y[i + 2];
+					sums[3] += x[i + 3] * y[i + 3];
+				}
+				for (; i < n; ++i) {
+					sums[0] += x[i] * y[i];
+				}
+				return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+			}
+
+			constexpr auto set = kernels{add, subtract, multiply, divide, dot};
+		} // namespace portable
+
+#if defined(COMP6771_EUCLIDEAN_VECTOR_X86_DISPATCH)
+		// 4 doubles per register. The tail that does not fill a register uses a masked load and store.
+		namespace avx2 {
+			__attribute__((target("avx2,fma"))) auto tail_mask(std::size_t rest) -> __m256i {
+				auto const lanes = _mm256_set_epi64x(3, 2, 1, 0);
+				return _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(rest)), lanes);
+			}
+
+			__attribute__((target("avx2,fma"))) auto
+			add(double* out, double const* x, double const* y, std::size_t n) -> void {
+				auto i = std::size_t{0};
+				for (; i + 4 <= n; i += 4) {
+					auto const result = _mm256_add_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+					_mm256_storeu_pd(out + i, result);
+				}
+				if (i < n) {
+					auto const mask = tail_mask(n - i);
+					_mm256_maskstore_pd(out + i,
+					                    mask,
+					                    _mm256_add_pd(_mm256_maskload_pd(x + i, mask),
+					                                  _mm256_maskload_pd(y + i, mask)));
+				}
+			}
+			__attribute__((target("avx2,fma"))) auto
+			subtract(double* out, double const* x, double const* y, std::size_t n) -> void {
+				auto i = std::size_t{0};
+				for (; i + 4 <= n; i += 4) {
+					auto const result = _mm256_sub_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+					_mm256_storeu_pd(out + i, result);
+				}
+				if (i < n) {
+					auto const mask = tail_mask(n - i);
+					_mm256_maskstore_pd(out + i,
+					                    mask,
+					                    _mm256_sub_pd(_mm256_maskload_pd(x + i, mask),
+					                                  _mm256_maskload_pd(y + i, mask)));
+				}
+			}
+			__attribute__((target("avx2,fma"))) auto
+			multiply(double* out, double const* x, double d, std::size_t n) -> void {
+				auto const by = _mm256_set1_pd(d);
+				auto i = std::size_t{0};
+				for (; i + 4 <= n; i += 4) {
+					_mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(x + i), by));
+				}
+				if (i < n) {
+					auto const mask = tail_mask(n - i);
+					_mm256_maskstore_pd(out + i,
+					                    mask,
+					                    _mm256_mul_pd(_mm256_maskload_pd(x + i, mask), by));
+				}
+			}
+			__attribute__((target("avx2,fma"))) auto
+			divide(double* out, double const* x, double d, std::size_t n) -> void {
+				auto const by = _mm256_set1_pd(d);
+				auto i = std::size_t{0};
+				for (; i + 4 <= n; i += 4) {
+					_mm256_storeu_pd(out + i, _mm256_div_pd(_mm256_loadu_pd(x + i), by));
+				}
+				if (i < n) {
+					auto const mask = tail_mask(n - i);
+					_mm256_maskstore_pd(out + i,
+					                    mask,
+					                    _mm256_div_pd(_mm256_maskload_pd(x + i, mask), by));
+				}
+			}
+			__attribute__((target("avx2,fma"))) auto dot(double const* x, double const* y, std::size_t n)
+			   -> double {
+				// Two accumulators to hide the latency of the fused multiply-add
+				auto sum0 = _mm256_setzero_pd();
+				auto sum1 = _mm256_setzero_pd();
+				auto i = std::size_t{0};
+				for (; i + 8 <= n; i += 8) {
+					sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), sum0);
+					sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), sum1);
+				}
+				for (; i + 4 <= n; i += 4) {
+					sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), sum0);
+				}
+				if (i < n) {
+					auto const mask = tail_mask(n - i);
+					sum1 = _mm256_fmadd_pd(_mm256_maskload_pd(x + i, mask),
+					                       _mm256_maskload_pd(y + i, mask),
+					                       sum1);
+				}
+				auto const sum = _mm256_add_pd(sum0, sum1);
+				auto const half = _mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1));
+				return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+			}
+
+			constexpr auto set = kernels{add, subtract, multiply, divide, dot};
+		} // namespace avx2
+
+		// 8 doubles per register, with the tail handled by AVX-512's own lane masks
+		namespace avx512 {
+			__attribute__((target("avx512f"))) auto tail_mask(std::size_t rest) -> __mmask8 {
+				return static_cast<__mmask8>((1U << rest) - 1);
+			}
+
+			__attribute__((target("avx512f"))) auto
+			add(double* out, double const* x, double const* y, std::size_t n) -> void {
+				auto i = std::size_t{0};
+				for (; i + 8 <= n; i += 8) {
+					auto const result = _mm512_add_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i));
+					_mm512_storeu_pd(out + i, result);
+				}
+				if (i < n) {
+					auto const mask = tail_mask(n - i);
+					_mm512_mask_storeu_pd(out + i,
+					                      mask,
+					                      _mm512_add_pd(_mm512_maskz_loadu_pd(mask, x + i),
+					                                    _mm512_maskz_loadu_pd(mask, y + i)));
+				}
+			}
+			__attribute__((target("avx512f"))) auto
+			subtract(double* out, double const* x, double const* y, std::size_t n) -> void {
+				auto i = std::size_t{0};
+				for (; i + 8 <= n; i += 8) {
+					auto const result = _mm512_sub_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i));
+					_mm512_storeu_pd(out + i, result);
+				}
+				if (i < n) {
+					auto const mask = tail_mask(n - i);
+					_mm512_mask_storeu_pd(out + i,
+					                      mask,
+					                      _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, x + i),
+					                                    _mm512_maskz_loadu_pd(mask, y + i)));
+				}
+			}
+			__attribute__((target("avx512f"))) auto
+			multiply(double* out, double const* x, double d, std::size_t n) -> void {
+				auto const by = _mm512_set1_pd(d);
+				auto i = std::size_t{0};
+				for (; i + 8 <= n; i += 8) {
+					_mm512_storeu_pd(out + i, _mm512_mul_pd(_mm512_loadu_pd(x + i), by));
+				}
+				if (i < n) {
+					auto const mask = tail_mask(n - i);
+					_mm512_mask_storeu_pd(out + i,
+					                      mask,
+					                      _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, x + i), by));
+				}
+			}
+			__attribute__((target("avx512f"))) auto
+			divide(double* out, double const* x, double d, std::size_t n) -> void {
+				auto const by = _mm512_set1_pd(d);
+				auto i = std::size_t{0};
+				for (; i + 8 <= n; i += 8) {
+					_mm512_storeu_pd(out + i, _mm512_div_pd(_mm512_loadu_pd(x + i), by));
+				}
+				if (i < n) {
+					auto const mask = tail_mask(n - i);
+					_mm512_mask_storeu_pd(out + i,
+					                      mask,
+					                      _mm512_div_pd(_mm512_maskz_loadu_pd(mask, x + i), by));
+				}
+			}
+			__attribute__((target("avx512f"))) auto dot(double const* x, double const* y, std::size_t n)
+			   -> double {
+				auto sum0 = _mm512_setzero_pd();
+				auto sum1 = _mm512_setzero_pd();
+				auto i = std::size_t{0};
+				for (; i + 16 <= n; i += 16) {
+					sum0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), sum0);
+					sum1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8), sum1);
+				}
+				for (; i + 8 <= n; i += 8) {
+					sum0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), sum0);
+				}
+				if (i < n) {
+					auto const mask = tail_mask(n - i);
+					sum1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, x + i),
+					                       _mm512_maskz_loadu_pd(mask, y + i),
+					                       sum1);
+				}
+				auto lanes = std::array<double, 8>{};
+				_mm512_storeu_pd(lanes.data(), _mm512_add_pd(sum0, sum1));
+				return ((lanes[0] + lanes[4]) + (lanes[1] + lanes[5]))
+				       + ((lanes[2] + lanes[6]) + (lanes[3] + lanes[7]));
+			}
+
+			constexpr auto set = kernels{add, subtract, multiply, divide, dot};
+		} // namespace avx512
+#endif
+
+		auto pick_kernels() -> kernels {
+#if defined(COMP6771_EUCLIDEAN_VECTOR_X86_DISPATCH)
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx512f")) {
+				return avx512::set;
+			}
+			if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+				return avx2::set;
+			}
+#endif
+			return portable::set;
+		}
+
+		auto simd() -> kernels const& {
+			static auto const chosen = pick_kernels();
+			return chosen;
+		}
+
+		// Vectors that fit in a magnitude_buffer's inline storage are too short for the wide kernels
+		// to win back the guarded static and the indirect call, so they run the portable loops,
+		// which inline here.
+		constexpr auto dispatch_threshold = detail::magnitude_buffer::inline_capacity;
+
+		auto dot_product(double const* x, double const* y, std::size_t n) -> double {
+			return n <= dispatch_threshold ? portable::dot(x, y, n) : simd().dot(x, y, n);
+		}
+	} // namespace
+
+	namespace detail {
+		auto add(double* out, double const* x, double const* y, std::size_t n) noexcept -> void {
+			if (n <= dispatch_threshold) {
+				portable::add(out, x, y, n);
+			}
+			else {
+				simd().add(out, x, y, n);
+			}
+		}
+		auto subtract(double* out, double const* x, double const* y, std::size_t n) noexcept -> void {
+			if (n <= dispatch_threshold) {
+				portable::subtract(out, x, y, n);
+			}
+			else {
+				simd().subtract(out, x, y, n);
+			}
+		}
+		auto multiply(double* out, double const* x, double d, std::size_t n) noexcept -> void {
+			if (n <= dispatch_threshold) {
+				portable::multiply(out, x, d, n);
+			}
+			else {
+				simd().multiply(out, x, d, n);
+			}
+		}
+		auto divide(double* out, double const* x, double d, std::size_t n) noexcept -> void {
+			if (n <= dispatch_threshold) {
+				portable::divide(out, x, d, n);
+			}
+			else {
+				simd().divide(out, x, d, n);
+			}
+		}
+	} // namespace detail
+
 	// namespace views = ranges::views;
 	// Part1: Constrctors
 	euclidean_vector::euclidean_vector() noexcept
 	: dimension_(1)
-	// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-	, magnitudes_(std::make_unique<double[]>(1))
+	, magnitudes_(1)
 	, cache_(-1) {
 		magnitudes_[0] = 0.0;
 	}
 
 	euclidean_vector::euclidean_vector(int dim) noexcept
 	: dimension_(dim)
-	// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-	, magnitudes_(std::make_unique<double[]>(narrow_cast<std::size_t>(dim)))
+	, magnitudes_(narrow_cast<std::size_t>(dim))
 	, cache_(-1) {
 		ranges::fill(magnitudes_.get(), magnitudes_.get() + dim, 0.0);
 	}
 
 	euclidean_vector::euclidean_vector(int dim, double mag) noexcept
 	: dimension_(dim)
-	// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-	, magnitudes_(std::make_unique<double[]>(narrow_cast<std::size_t>(dim)))
+	, magnitudes_(narrow_cast<std::size_t>(dim))
 	, cache_(-1) {
 		ranges::fill(magnitudes_.get(), magnitudes_.get() + dim, mag);
 	}
@@ -44,16 +351,14 @@ namespace comp6771 {
 	                                   std::vector<double>::const_iterator end) noexcept {
 		dimension_ = int(end - start);
 		auto d = narrow_cast<std::size_t>(dimension_);
-		// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-		magnitudes_ = std::make_unique<double[]>(d);
+		magnitudes_ = detail::magnitude_buffer(d);
 		ranges::copy(start, end, magnitudes_.get());
 		cache_ = -1;
 	}
 
 	euclidean_vector::euclidean_vector(std::initializer_list<double> l) noexcept {
 		dimension_ = static_cast<int>(l.size());
-		// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-		magnitudes_ = std::make_unique<double[]>(l.size());
+		magnitudes_ = detail::magnitude_buffer(l.size());
 		ranges::copy(l.begin(), l.end(), magnitudes_.get());
 		cache_ = -1;
 	}
@@ -61,8 +366,7 @@ namespace comp6771 {
 	// Copy Constructor
 	euclidean_vector::euclidean_vector(euclidean_vector const& ev) noexcept
 	: dimension_(ev.dimension_)
-	// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-	, magnitudes_{std::make_unique<double[]>(narrow_cast<std::size_t>(ev.dimension_))}
+	, magnitudes_(narrow_cast<std::size_t>(ev.dimension_))
 	, cache_(-1) {
 		ranges::copy(ev.magnitudes_.get(), ev.magnitudes_.get() + ev.dimension_, magnitudes_.get());
 	}
@@ -70,7 +374,7 @@ namespace comp6771 {
 	// Move Constructor
 	euclidean_vector::euclidean_vector(euclidean_vector&& ev) noexcept
 	: dimension_(std::exchange(ev.dimension_, 0))
-	, magnitudes_(std::exchange(ev.magnitudes_, nullptr))
+	, magnitudes_(std::move(ev.magnitudes_))
 	, cache_(-1) {}
 
 	// Part3: Operations
@@ -115,19 +419,9 @@ namespace comp6771 {
 	// Compound Addition
 	auto euclidean_vector::euclidean_vector::operator+=(euclidean_vector const& cur)
 	   -> euclidean_vector& {
-		if (this->dimension_ != cur.dimension_) {
-			auto e = std::stringstream();
-			e << "Dimensions of LHS(" << this->dimension_ << ") and RHS(" << cur.dimension_
-			  << ") do not match";
-			throw euclidean_vector_error(e.str());
-		}
-
-		ranges::transform(magnitudes_.get(),
-		                  magnitudes_.get() + dimension_,
-		                  cur.magnitudes_.get(),
-		                  cur.magnitudes_.get() + dimension_,
-		                  magnitudes_.get(),
-		                  ranges::plus{});
+		check_dimensions(cur.dimension_);
+		auto* const x = magnitudes_.get();
+		detail::add(x, x, cur.magnitudes_.get(), narrow_cast<std::size_t>(dimension_));
 		this->cache_ = -1;
 		return *this;
 	}
@@ -135,28 +429,17 @@ namespace comp6771 {
 	// Compound Subtract
 	auto euclidean_vector::euclidean_vector::operator-=(euclidean_vector const& cur)
 	   -> euclidean_vector& {
-		if (this->dimension_ != cur.dimension_) {
-			auto e = std::stringstream();
-			e << "Dimensions of LHS(" << this->dimension_ << ") and RHS(" << cur.dimension_
-			  << ") do not match";
-			throw euclidean_vector_error(e.str());
-		}
-		ranges::transform(magnitudes_.get(),
-		                  magnitudes_.get() + dimension_,
-		                  cur.magnitudes_.get(),
-		                  cur.magnitudes_.get() + dimension_,
-		                  magnitudes_.get(),
-		                  ranges::minus{});
+		check_dimensions(cur.dimension_);
+		auto* const x = magnitudes_.get();
+		detail::subtract(x, x, cur.magnitudes_.get(), narrow_cast<std::size_t>(dimension_));
 		this->cache_ = -1;
 		return *this;
 	}
 
 	// Compound Multiplication
 	auto euclidean_vector::euclidean_vector::operator*=(double d) noexcept -> euclidean_vector& {
-		ranges::transform(magnitudes_.get(),
-		                  magnitudes_.get() + dimension_,
-		                  magnitudes_.get(),
-		                  [&d](auto const& x) { return x * d; });
+		auto* const x = magnitudes_.get();
+		detail::multiply(x, x, d, narrow_cast<std::size_t>(dimension_));
 		this->cache_ = -1;
 		return *this;
 	}
@@ -166,10 +449,8 @@ namespace comp6771 {
 		if (d == 0) {
 			throw euclidean_vector_error("Invalid vector division by 0");
 		}
-		ranges::transform(magnitudes_.get(),
-		                  magnitudes_.get() + dimension_,
-		                  magnitudes_.get(),
-		                  [&d](auto const& x) { return x / d; });
+		auto* const x = magnitudes_.get();
+		detail::divide(x, x, d, narrow_cast<std::size_t>(dimension_));
 		this->cache_ = -1;
 		return *this;
 	}
@@ -177,16 +458,18 @@ namespace comp6771 {
 	// Vector Type Conversion
 	euclidean_vector::euclidean_vector::operator std::vector<double>() const noexcept {
 		auto vec = std::vector<double>{};
-		ranges::copy(std::span<double>(magnitudes_.get(), narrow_cast<std::size_t>(dimension_)),
-		             ranges::back_inserter(vec));
+		auto const magnitudes =
+		   std::span<double const>(magnitudes_.get(), narrow_cast<std::size_t>(dimension_));
+		ranges::copy(magnitudes, ranges::back_inserter(vec));
 		return vec;
 	}
 
 	// List Type Conversion
 	euclidean_vector::euclidean_vector::operator std::list<double>() const noexcept {
 		auto l = std::list<double>{};
-		ranges::copy(std::span<double>(magnitudes_.get(), narrow_cast<std::size_t>(dimension_)),
-		             ranges::back_inserter(l));
+		auto const magnitudes =
+		   std::span<double const>(magnitudes_.get(), narrow_cast<std::size_t>(dimension_));
+		ranges::copy(magnitudes, ranges::back_inserter(l));
 		return l;
 	}
 
@@ -214,6 +497,15 @@ namespace comp6771 {
 		return this->dimension_;
 	}
 
+	auto euclidean_vector::check_dimensions(int dimension) const -> void {
+		if (this->dimension_ != dimension) {
+			auto e = std::stringstream();
+			e << "Dimensions of LHS(" << this->dimension_ << ") and RHS(" << dimension
+			  << ") do not match";
+			throw euclidean_vector_error(e.str());
+		}
+	}
+
 	// Part6: Utility functions
 	auto euclidean_norm(euclidean_vector const& ev) -> double {
 		if (ev.dimension_ == 0) {
@@ -222,10 +514,9 @@ namespace comp6771 {
 		}
 		// Calculate cache if cache is not set up
 		if (ev.cache_ == -1) {
-			auto sum_squares = double{0};
-			ranges::for_each (ev.magnitudes_.get(),
-			                  ev.magnitudes_.get() + ev.dimensions(),
-			                  [&sum_squares](auto d) { sum_squares += d * d; });
+			auto const sum_squares = dot_product(ev.magnitudes_.get(),
+			                                     ev.magnitudes_.get(),
+			                                     narrow_cast<std::size_t>(ev.dimension_));
 			ev.cache_ = sqrt(sum_squares);
 			return sqrt(sum_squares);
 		}
@@ -254,6 +545,6 @@ namespace comp6771 {
 			  << ") do not match";
 			throw euclidean_vector_error(e.str());
 		}
-		return std::inner_product(a.begin(), a.end(), b.begin(), 0.0);
+		return dot_product(a.begin(), b.begin(), narrow_cast<std::size_t>(a.dimensions()));
 	}
 } // namespace comp6771
@@ -0,0 +1,188 @@
+#include "comp6771/euclidean_vector_batch.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <new>
+#include <span>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace comp6771 {
+	namespace {
+		// Rows are worked through this many at a time, so the running sums for a block stay in L1
+		// while each of its columns streams past once
+		constexpr auto block_size = std::size_t{256};
+
+		// Doubles per column, rounded up so every column starts on an alignment boundary
+		auto column_stride(std::size_t size) noexcept -> std::size_t {
+			constexpr auto per_line = euclidean_vector_batch::alignment / sizeof(double);
+			return (size + per_line - 1) / per_line * per_line;
+		}
+
+		auto check_dimensions(int lhs, int rhs) -> void {
+			if (lhs != rhs) {
+				auto e = std::stringstream();
+				e << "Dimensions of LHS(" << lhs << ") and RHS(" << rhs << ") do not match";
+				throw euclidean_vector_error(e.str());
+			}
+		}
+
+		auto check_has_norm(euclidean_vector_batch const& batch) -> void {
+			if (batch.dimensions() == 0) {
+				throw euclidean_vector_error("euclidean_vector with no dimensions does not have a "
+				                             "norm");
+			}
+		}
+
+		// sums[i] = the dot product of rows first + i of x and y, for i < n
+		auto block_dot(euclidean_vector_batch const& x,
+		               euclidean_vector_batch const& y,
+		               std::size_t first,
+		               std::size_t n,
+		               double* sums) noexcept -> void {
+			std::fill_n(sums, n, 0.0);
+			for (auto j = 0; j < x.dimensions(); ++j) {
+				auto const* const xs = x.column(j).data() + first;
+				auto const* const ys = y.column(j).data() + first;
+				for (auto i = std::size_t{0}; i < n; ++i) {
+					sums[i] += xs[i] * ys[i];
+				}
+			}
+		}
+	} // namespace
+
+	// Part1: Constructors
+	euclidean_vector_batch::euclidean_vector_batch(std::size_t size, int dimension)
+	: size_(size)
+	, dimension_(dimension)
+	, stride_(column_stride(size)) {
+		auto const n = stride_ * static_cast<std::size_t>(dimension_);
+		if (n != 0) {
+			data_.reset(static_cast<double*>(
+			   ::operator new[](n * sizeof(double), std::align_val_t{alignment})));
+			// The padding is zeroed too, so nothing in the buffer is ever uninitialised
+			std::fill_n(data_.get(), n, 0.0);
+		}
+	}
+
+	euclidean_vector_batch::euclidean_vector_batch(std::span<euclidean_vector const> vectors)
+	: euclidean_vector_batch(vectors.size(), vectors.empty() ? 0 : vectors.front().dimensions()) {
+		for (auto i = std::size_t{0}; i < size_; ++i) {
+			check_dimensions(dimension_, vectors[i].dimensions());
+			(*this)[i] = vectors[i];
+		}
+	}
+
+	// Copy Constructor
+	euclidean_vector_batch::euclidean_vector_batch(euclidean_vector_batch const& batch)
+	: euclidean_vector_batch(batch.size_, batch.dimension_) {
+		std::copy_n(batch.data_.get(), stride_ * static_cast<std::size_t>(dimension_), data_.get());
+	}
+
+	// Move Constructor, leaving batch empty
+	euclidean_vector_batch::euclidean_vector_batch(euclidean_vector_batch&& batch) noexcept
+	: size_(std::exchange(batch.size_, 0))
+	, dimension_(std::exchange(batch.dimension_, 0))
+	, stride_(std::exchange(batch.stride_, 0))
+	, data_(std::move(batch.data_)) {}
+
+	// Copy Assignment
+	auto euclidean_vector_batch::operator=(euclidean_vector_batch const& batch)
+	   -> euclidean_vector_batch& {
+		if (this == &batch) {
+			return *this;
+		}
+		auto copy = batch;
+		std::swap(copy, *this);
+		return *this;
+	}
+
+	// Move Assignment, leaving batch empty
+	auto euclidean_vector_batch::operator=(euclidean_vector_batch&& batch) noexcept
+	   -> euclidean_vector_batch& {
+		if (this == &batch) {
+			return *this;
+		}
+		size_ = std::exchange(batch.size_, 0);
+		dimension_ = std::exchange(batch.dimension_, 0);
+		stride_ = std::exchange(batch.stride_, 0);
+		data_ = std::move(batch.data_);
+		return *this;
+	}
+
+	// Part4: Member Functions
+	auto euclidean_vector_batch::at(std::size_t i) -> euclidean_vector_row<double> {
+		if (i >= size_) {
+			auto e = std::stringstream();
+			e << "Index " << i << " is not valid for this euclidean_vector_batch object";
+			throw euclidean_vector_error(e.str());
+		}
+		return (*this)[i];
+	}
+
+	auto euclidean_vector_batch::at(std::size_t i) const -> euclidean_vector_row<double const> {
+		if (i >= size_) {
+			auto e = std::stringstream();
+			e << "Index " << i << " is not valid for this euclidean_vector_batch object";
+			throw euclidean_vector_error(e.str());
+		}
+		return (*this)[i];
+	}
+
+	// Part6: Utility functions
+	auto dot(euclidean_vector_batch const& a, euclidean_vector_batch const& b)
+	   -> std::vector<double> {
+		check_dimensions(a.dimensions(), b.dimensions());
+		if (a.size() != b.size()) {
+			auto e = std::stringstream();
+			e << "Sizes of LHS(" << a.size() << ") and RHS(" << b.size() << ") do not match";
+			throw euclidean_vector_error(e.str());
+		}
+		auto products = std::vector<double>(a.size());
+		for (auto first = std::size_t{0}; first < a.size(); first += block_size) {
+			auto const n = std::min(block_size, a.size() - first);
+			block_dot(a, b, first, n, products.data() + first);
+		}
+		return products;
+	}
+
+	auto euclidean_norm(euclidean_vector_batch const& batch) -> std::vector<double> {
+		check_has_norm(batch);
+		auto norms = std::vector<double>(batch.size());
+		for (auto first = std::size_t{0}; first < batch.size(); first += block_size) {
+			auto const n = std::min(block_size, batch.size() - first);
+			auto* const block = norms.data() + first;
+			block_dot(batch, batch, first, n, block);
+			std::transform(block, block + n, block, [](double d) { return std::sqrt(d); });
+		}
+		return norms;
+	}
+
+	auto unit(euclidean_vector_batch const& batch) -> euclidean_vector_batch {
+		check_has_norm(batch);
+		auto units = euclidean_vector_batch(batch.size(), batch.dimensions());
+		auto norms = std::array<double, block_size>{};
+		for (auto first = std::size_t{0}; first < batch.size(); first += block_size) {
+			auto const n = std::min(block_size, batch.size() - first);
+			block_dot(batch, batch, first, n, norms.data());
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				norms[i] = std::sqrt(norms[i]);
+				if (norms[i] == 0) {
+					throw euclidean_vector_error("euclidean_vector with zero euclidean normal does not "
+					                             "have a unit vector");
+				}
+			}
+			// The block was just read to find its norms, so this pass is served from cache
+			for (auto j = 0; j < batch.dimensions(); ++j) {
+				auto const* const from = batch.column(j).data() + first;
+				auto* const to = units.column(j).data() + first;
+				for (auto i = std::size_t{0}; i < n; ++i) {
+					to[i] = from[i] / norms[i];
+				}
+			}
+		}
+		return units;
+	}
+} // namespace comp6771
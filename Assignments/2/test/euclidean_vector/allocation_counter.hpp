@@ -0,0 +1,102 @@
+#ifndef COMP6771_ALLOCATION_COUNTER_HPP
+#define COMP6771_ALLOCATION_COUNTER_HPP
+
+// Replaces the global operator new and delete, so include this in exactly one file of a test
+// program.
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+	// Counts every allocation made through the global operator new in this program. Every form of
+	// new and delete is replaced below, so they all agree on where memory comes from: malloc, or
+	// aligned_alloc when an alignment is asked for, and free.
+	std::size_t allocations = 0;
+
+	auto allocate(std::size_t size) noexcept -> void* {
+		++allocations;
+		return std::malloc(size == 0 ? 1 : size);
+	}
+
+	auto allocate(std::size_t size, std::align_val_t alignment) noexcept -> void* {
+		++allocations;
+		auto const align = static_cast<std::size_t>(alignment);
+		// aligned_alloc wants a size that is a multiple of the alignment
+		auto const rounded = size == 0 ? align : (size + align - 1) / align * align;
+		return std::aligned_alloc(align, rounded);
+	}
+
+	auto allocate_or_throw(void* p) -> void* {
+		if (p == nullptr) {
+			throw std::bad_alloc();
+		}
+		return p;
+	}
+} // namespace
+
+auto operator new(std::size_t size) -> void* {
+	return allocate_or_throw(allocate(size));
+}
+auto operator new[](std::size_t size) -> void* {
+	return allocate_or_throw(allocate(size));
+}
+auto operator new(std::size_t size, std::nothrow_t const&) noexcept -> void* {
+	return allocate(size);
+}
+auto operator new[](std::size_t size, std::nothrow_t const&) noexcept -> void* {
+	return allocate(size);
+}
+auto operator new(std::size_t size, std::align_val_t alignment) -> void* {
+	return allocate_or_throw(allocate(size, alignment));
+}
+auto operator new[](std::size_t size, std::align_val_t alignment) -> void* {
+	return allocate_or_throw(allocate(size, alignment));
+}
+auto operator new(std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept
+   -> void* {
+	return allocate(size, alignment);
+}
+auto operator new[](std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept
+   -> void* {
+	return allocate(size, alignment);
+}
+
+auto operator delete(void* p) noexcept -> void {
+	std::free(p);
+}
+auto operator delete[](void* p) noexcept -> void {
+	std::free(p);
+}
+auto operator delete(void* p, std::size_t) noexcept -> void {
+	std::free(p);
+}
+auto operator delete[](void* p, std::size_t) noexcept -> void {
+	std::free(p);
+}
+auto operator delete(void* p, std::nothrow_t const&) noexcept -> void {
+	std::free(p);
+}
+auto operator delete[](void* p, std::nothrow_t const&) noexcept -> void {
+	std::free(p);
+}
+auto operator delete(void* p, std::align_val_t) noexcept -> void {
+	std::free(p);
+}
+auto operator delete[](void* p, std::align_val_t) noexcept -> void {
+	std::free(p);
+}
+auto operator delete(void* p, std::size_t, std::align_val_t) noexcept -> void {
+	std::free(p);
+}
+auto operator delete[](void* p, std::size_t, std::align_val_t) noexcept -> void {
+	std::free(p);
+}
+auto operator delete(void* p, std::align_val_t, std::nothrow_t const&) noexcept -> void {
+	std::free(p);
+}
+auto operator delete[](void* p, std::align_val_t, std::nothrow_t const&) noexcept -> void {
+	std::free(p);
+}
+
+#endif // COMP6771_ALLOCATION_COUNTER_HPP
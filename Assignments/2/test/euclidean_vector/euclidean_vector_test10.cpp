@@ -0,0 +1,94 @@
+#include "comp6771/fixed_euclidean_vector.hpp"
+
+#include "comp6771/euclidean_vector.hpp"
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <array>
+#include <type_traits>
+
+namespace {
+	template<typename L, typename R>
+	constexpr auto can_add = requires(L l, R r) { l + r; };
+	template<typename L, typename R>
+	constexpr auto can_dot = requires(L l, R r) { comp6771::dot(l, r); };
+} // namespace
+
+TEST_CASE("Fixed-dimension vectors") {
+	SECTION("Arithmetic runs in constant expressions") {
+		constexpr auto a = comp6771::fixed_euclidean_vector{1.0, 2.0, 3.0};
+		constexpr auto b = comp6771::fixed_euclidean_vector<3>(2.0);
+		STATIC_REQUIRE(a.dimensions() == 3);
+		STATIC_REQUIRE(a + b == comp6771::fixed_euclidean_vector{3.0, 4.0, 5.0});
+		STATIC_REQUIRE(a - b == comp6771::fixed_euclidean_vector{-1.0, 0.0, 1.0});
+		STATIC_REQUIRE(-a == comp6771::fixed_euclidean_vector{-1.0, -2.0, -3.0});
+		STATIC_REQUIRE(2 * a == a * 2);
+		STATIC_REQUIRE(a / 2 == comp6771::fixed_euclidean_vector{0.5, 1.0, 1.5});
+		STATIC_REQUIRE(comp6771::dot(a, b) == 12);
+		STATIC_REQUIRE(a != b);
+		STATIC_REQUIRE(comp6771::fixed_euclidean_vector<4>()[3] == 0);
+	}
+
+	SECTION("Dimension mismatches do not compile") {
+		using v2 = comp6771::fixed_euclidean_vector<2>;
+		using v3 = comp6771::fixed_euclidean_vector<3>;
+		STATIC_REQUIRE(can_add<v3, v3>);
+		STATIC_REQUIRE(not can_add<v2, v3>);
+		STATIC_REQUIRE(can_dot<v2, v2>);
+		STATIC_REQUIRE(not std::is_constructible_v<v3, double, double>);
+		STATIC_REQUIRE(sizeof(v3) == 3 * sizeof(double));
+	}
+
+	SECTION("Runtime operations and errors") {
+		auto a = comp6771::fixed_euclidean_vector{3.0, 4.0};
+		CHECK(comp6771::euclidean_norm(a) == 5);
+		CHECK(comp6771::unit(a) == comp6771::fixed_euclidean_vector{0.6, 0.8});
+		a.at(1) = 1;
+		CHECK(a[1] == 1);
+		CHECK_THROWS_WITH(a.at(2), "Index 2 is not valid for this euclidean_vector object");
+		CHECK_THROWS_WITH(a /= 0, "Invalid vector division by 0");
+		CHECK_THROWS_WITH(comp6771::unit(comp6771::fixed_euclidean_vector<2>()),
+		                  "euclidean_vector with zero euclidean normal does not have a unit vector");
+		CHECK(fmt::format("{}", a) == "[3 1]");
+		CHECK(static_cast<std::array<double, 2>>(a) == std::array<double, 2>{3, 1});
+	}
+
+	SECTION("Conversions to and from euclidean_vector") {
+		auto const fixed = comp6771::fixed_euclidean_vector{1.0, 2.0, 2.0};
+		auto const dynamic = comp6771::euclidean_vector(fixed);
+		CHECK(dynamic == comp6771::euclidean_vector{1, 2, 2});
+		CHECK(fixed == dynamic);
+		CHECK(comp6771::dot(fixed, dynamic) == 9);
+		CHECK(comp6771::euclidean_norm(comp6771::euclidean_vector(fixed)) == 3);
+
+		auto const back = comp6771::fixed_euclidean_vector<3>(dynamic + dynamic);
+		CHECK(back == fixed * 2);
+		CHECK_THROWS_WITH(comp6771::fixed_euclidean_vector<2>(dynamic),
+		                  "Dimensions of LHS(2) and RHS(3) do not match");
+	}
+
+	SECTION("Arithmetic with a euclidean_vector on the other side") {
+		auto fixed = comp6771::fixed_euclidean_vector{1.0, 2.0, 2.0};
+		auto dynamic = comp6771::euclidean_vector{0.5, 0.5, 1};
+		CHECK(fixed + dynamic == comp6771::euclidean_vector{1.5, 2.5, 3});
+		CHECK(dynamic + fixed == comp6771::euclidean_vector{1.5, 2.5, 3});
+		CHECK(fixed - dynamic == comp6771::euclidean_vector{0.5, 1.5, 1});
+		CHECK(dynamic - fixed == comp6771::euclidean_vector{-0.5, -1.5, -1});
+		CHECK(fixed * 2.0 - dynamic == comp6771::euclidean_vector{1.5, 3.5, 3});
+		CHECK(dynamic * 2.0 + 2.0 * fixed == comp6771::euclidean_vector{3, 5, 6});
+
+		dynamic = fixed + dynamic;
+		CHECK(dynamic == comp6771::euclidean_vector{1.5, 2.5, 3});
+		dynamic += fixed;
+		CHECK(dynamic == comp6771::euclidean_vector{2.5, 4.5, 5});
+
+		// Between fixed vectors the result stays fixed
+		STATIC_REQUIRE(std::is_same_v<decltype(fixed + fixed), comp6771::fixed_euclidean_vector<3>>);
+		STATIC_REQUIRE(std::is_same_v<decltype(-fixed), comp6771::fixed_euclidean_vector<3>>);
+		STATIC_REQUIRE(std::is_same_v<decltype(fixed * 2.0), comp6771::fixed_euclidean_vector<3>>);
+
+		auto const two = comp6771::fixed_euclidean_vector{1.0, 1.0};
+		CHECK_THROWS_WITH(two + dynamic, "Dimensions of LHS(2) and RHS(3) do not match");
+		CHECK_THROWS_WITH(dynamic - two, "Dimensions of LHS(3) and RHS(2) do not match");
+	}
+}
@@ -0,0 +1,158 @@
+#include "comp6771/euclidean_vector_batch.hpp"
+
+#include "comp6771/euclidean_vector.hpp"
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <utility>
+#include <vector>
+
+namespace {
+	// Enough rows to span several blocks of the batched kernels, ending part way through one
+	constexpr auto rows = std::size_t{1000};
+
+	auto make(std::size_t i, int dimension) -> comp6771::euclidean_vector {
+		auto v = comp6771::euclidean_vector(dimension);
+		for (auto j = 0; j < dimension; ++j) {
+			v[j] = static_cast<double>(i % 17) - 0.25 * j + 1;
+		}
+		return v;
+	}
+} // namespace
+
+TEST_CASE("Batches of euclidean_vectors") {
+	SECTION("Rows behave like the vectors they were built from") {
+		auto const vectors = std::vector<comp6771::euclidean_vector>{{1, 2, 3}, {4, 5, 6}};
+		auto batch = comp6771::euclidean_vector_batch(vectors);
+		CHECK(batch.size() == 2);
+		CHECK(batch.dimensions() == 3);
+		CHECK(batch[1] == comp6771::euclidean_vector{4, 5, 6});
+		CHECK(batch[0].at(2) == 3);
+		CHECK(fmt::format("{}", batch[0]) == "[1 2 3]");
+		CHECK(comp6771::euclidean_norm(batch[1]) == Approx(std::sqrt(77.0)));
+
+		batch[0][1] = 7;
+		batch[1] = batch[0];
+		CHECK(batch[1] == comp6771::euclidean_vector{1, 7, 3});
+		CHECK(batch.column(1)[0] == 7);
+		CHECK(batch.column(1)[1] == 7);
+
+		auto const copy = batch;
+		batch[0] = comp6771::euclidean_vector(3, 0.0);
+		CHECK(copy[0] == comp6771::euclidean_vector{1, 7, 3});
+		CHECK(batch[0] == comp6771::euclidean_vector(3, 0.0));
+	}
+
+	SECTION("Rows take part in arithmetic") {
+		auto const vectors = std::vector<comp6771::euclidean_vector>{{1, 2, 3}, {4, 5, 6}};
+		auto batch = comp6771::euclidean_vector_batch(vectors);
+		auto const& read_only = batch;
+		auto const v = comp6771::euclidean_vector{0.5, 0.5, 0.5};
+		CHECK(batch[0] + v == comp6771::euclidean_vector{1.5, 2.5, 3.5});
+		CHECK(v - read_only[1] == comp6771::euclidean_vector{-3.5, -4.5, -5.5});
+		CHECK(batch[1] - batch[0] == comp6771::euclidean_vector(3, 3.0));
+		CHECK(batch[0] * 2.0 == comp6771::euclidean_vector{2, 4, 6});
+		CHECK(2.0 * read_only[0] / 4.0 == comp6771::euclidean_vector{0.5, 1, 1.5});
+		CHECK(-batch[0] == comp6771::euclidean_vector{-1, -2, -3});
+		CHECK(comp6771::euclidean_vector(batch[0] + batch[1]) == comp6771::euclidean_vector{5, 7, 9});
+		CHECK_THROWS_WITH(batch[0] + comp6771::euclidean_vector(2),
+		                  "Dimensions of LHS(3) and RHS(2) do not match");
+
+		// Assigning an expression writes straight into the batch, even when it reads the same row
+		batch[1] = batch[1] - batch[0] * 2.0;
+		CHECK(batch[1] == comp6771::euclidean_vector{2, 1, 0});
+		batch[0] = -batch[0];
+		CHECK(batch[0] == comp6771::euclidean_vector{-1, -2, -3});
+		auto const two = comp6771::euclidean_vector(2);
+		CHECK_THROWS_WITH(batch[0] = two * 2.0, "Dimensions of LHS(3) and RHS(2) do not match");
+	}
+
+	SECTION("Columns are aligned") {
+		auto const batch = comp6771::euclidean_vector_batch(13, 4);
+		for (auto j = 0; j < batch.dimensions(); ++j) {
+			auto const address = reinterpret_cast<std::uintptr_t>(batch.column(j).data());
+			CHECK(address % comp6771::euclidean_vector_batch::alignment == 0);
+			CHECK(batch.column(j).size() == 13);
+		}
+		CHECK(batch[12] == comp6771::euclidean_vector(4, 0.0));
+	}
+
+	SECTION("Batched kernels match the single-vector ones") {
+		for (auto dimension : {1, 3, 9}) {
+			auto a = comp6771::euclidean_vector_batch(rows, dimension);
+			auto b = comp6771::euclidean_vector_batch(rows, dimension);
+			for (auto i = std::size_t{0}; i < rows; ++i) {
+				a[i] = make(i, dimension);
+				b[i] = make(i * 7 + 3, dimension);
+			}
+			auto const products = comp6771::dot(a, b);
+			auto const norms = comp6771::euclidean_norm(a);
+			auto const units = comp6771::unit(a);
+			REQUIRE(products.size() == rows);
+			REQUIRE(norms.size() == rows);
+			REQUIRE(units.size() == rows);
+			for (auto i = std::size_t{0}; i < rows; ++i) {
+				CHECK(products[i] == Approx(comp6771::dot(a[i], b[i])));
+				CHECK(norms[i] == Approx(comp6771::euclidean_norm(a[i])));
+				CHECK(units[i] == comp6771::unit(a[i]));
+			}
+		}
+	}
+
+	SECTION("Copying and moving") {
+		auto const vectors = std::vector<comp6771::euclidean_vector>{{1, 2, 3}, {4, 5, 6}};
+		auto batch = comp6771::euclidean_vector_batch(vectors);
+
+		auto moved = std::move(batch);
+		CHECK(moved.size() == 2);
+		CHECK(moved.dimensions() == 3);
+		CHECK(moved[1] == comp6771::euclidean_vector{4, 5, 6});
+		// NOLINTNEXTLINE(bugprone-use-after-move)
+		CHECK(batch.size() == 0);
+		CHECK(batch.dimensions() == 0);
+
+		// A moved-from batch is empty, and can still be copied and assigned to
+		auto const empty = batch;
+		CHECK(empty.size() == 0);
+		CHECK(empty.dimensions() == 0);
+		batch = moved;
+		CHECK(batch[0] == comp6771::euclidean_vector{1, 2, 3});
+
+		auto assigned = comp6771::euclidean_vector_batch(5, 1);
+		assigned = std::move(moved);
+		CHECK(assigned.size() == 2);
+		CHECK(assigned[1] == comp6771::euclidean_vector{4, 5, 6});
+		// NOLINTNEXTLINE(bugprone-use-after-move)
+		CHECK(moved.size() == 0);
+		CHECK(moved.dimensions() == 0);
+		moved = empty;
+		CHECK(moved.size() == 0);
+
+		auto& self = assigned;
+		assigned = std::move(self);
+		CHECK(assigned[0] == comp6771::euclidean_vector{1, 2, 3});
+	}
+
+	SECTION("Errors") {
+		auto const vectors = std::vector<comp6771::euclidean_vector>{{1, 2}, {1, 2, 3}};
+		CHECK_THROWS_WITH(comp6771::euclidean_vector_batch(vectors),
+		                  "Dimensions of LHS(2) and RHS(3) do not match");
+
+		auto batch = comp6771::euclidean_vector_batch(2, 2);
+		CHECK_THROWS_WITH(batch.at(2), "Index 2 is not valid for this euclidean_vector_batch object");
+		CHECK_THROWS_WITH(batch[0].at(2), "Index 2 is not valid for this euclidean_vector object");
+		CHECK_THROWS_WITH(batch[0] = comp6771::euclidean_vector(3),
+		                  "Dimensions of LHS(2) and RHS(3) do not match");
+		CHECK_THROWS_WITH(comp6771::dot(batch, comp6771::euclidean_vector_batch(3, 2)),
+		                  "Sizes of LHS(2) and RHS(3) do not match");
+		CHECK_THROWS_WITH(comp6771::dot(batch, comp6771::euclidean_vector_batch(2, 3)),
+		                  "Dimensions of LHS(2) and RHS(3) do not match");
+		CHECK_THROWS_WITH(comp6771::unit(batch),
+		                  "euclidean_vector with zero euclidean normal does not have a unit vector");
+		CHECK_THROWS_WITH(comp6771::euclidean_norm(comp6771::euclidean_vector_batch(2, 0)),
+		                  "euclidean_vector with no dimensions does not have a norm");
+	}
+}
@@ -0,0 +1,92 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace {
+	// Distinct, non-round magnitudes so a lane handled twice or not at all shows up
+	auto make(int dim, double seed) -> std::vector<double> {
+		auto v = std::vector<double>{};
+		for (auto i = 0; i < dim; ++i) {
+			v.push_back(seed * (i + 1) - 0.37 * i * i);
+		}
+		return v;
+	}
+
+	// Every dimension up to a few full AVX-512 registers, so every length of tail is covered
+	constexpr auto max_dim = 40;
+} // namespace
+
+TEST_CASE("Vectorised kernels match the scalar results for every dimension") {
+	SECTION("Compound addition and subtraction") {
+		for (auto dim = 1; dim <= max_dim; ++dim) {
+			auto const x = make(dim, 1.25);
+			auto const y = make(dim, -0.5);
+			auto sum = comp6771::euclidean_vector(x.begin(), x.end());
+			sum += comp6771::euclidean_vector(y.begin(), y.end());
+			auto difference = comp6771::euclidean_vector(x.begin(), x.end());
+			difference -= comp6771::euclidean_vector(y.begin(), y.end());
+			for (auto i = std::size_t{0}; i < x.size(); ++i) {
+				CHECK(sum[static_cast<int>(i)] == x[i] + y[i]);
+				CHECK(difference[static_cast<int>(i)] == x[i] - y[i]);
+			}
+		}
+	}
+
+	SECTION("Compound multiplication and division") {
+		for (auto dim = 1; dim <= max_dim; ++dim) {
+			auto const x = make(dim, 1.25);
+			auto product = comp6771::euclidean_vector(x.begin(), x.end());
+			product *= 3.1;
+			auto quotient = comp6771::euclidean_vector(x.begin(), x.end());
+			quotient /= 3.1;
+			for (auto i = std::size_t{0}; i < x.size(); ++i) {
+				CHECK(product[static_cast<int>(i)] == x[i] * 3.1);
+				CHECK(quotient[static_cast<int>(i)] == x[i] / 3.1);
+			}
+		}
+	}
+
+	SECTION("Binary operators on whole vectors, including into one of their operands") {
+		for (auto dim = 1; dim <= max_dim; ++dim) {
+			auto const x = make(dim, 1.25);
+			auto const y = make(dim, -0.5);
+			auto const a = comp6771::euclidean_vector(x.begin(), x.end());
+			auto b = comp6771::euclidean_vector(y.begin(), y.end());
+			auto const sum = comp6771::euclidean_vector(a + b);
+			auto const difference = comp6771::euclidean_vector(a - b);
+			auto const product = comp6771::euclidean_vector(3.1 * a);
+			auto const quotient = comp6771::euclidean_vector(a / 3.1);
+			auto const negated = comp6771::euclidean_vector(-a);
+			b = a - b;
+			for (auto i = std::size_t{0}; i < x.size(); ++i) {
+				auto const j = static_cast<int>(i);
+				CHECK(sum[j] == x[i] + y[i]);
+				CHECK(difference[j] == x[i] - y[i]);
+				CHECK(product[j] == x[i] * 3.1);
+				CHECK(quotient[j] == x[i] / 3.1);
+				CHECK(negated[j] == -x[i]);
+				CHECK(b[j] == x[i] - y[i]);
+			}
+		}
+	}
+
+	SECTION("Dot product and norm") {
+		for (auto dim = 1; dim <= max_dim; ++dim) {
+			auto const x = make(dim, 1.25);
+			auto const y = make(dim, -0.5);
+			auto expected_dot = 0.0;
+			auto expected_squares = 0.0;
+			for (auto i = std::size_t{0}; i < x.size(); ++i) {
+				expected_dot += x[i] * y[i];
+				expected_squares += x[i] * x[i];
+			}
+			auto const a = comp6771::euclidean_vector(x.begin(), x.end());
+			auto const b = comp6771::euclidean_vector(y.begin(), y.end());
+			CHECK(comp6771::dot(a, b) == Approx(expected_dot));
+			CHECK(comp6771::euclidean_norm(a) == Approx(std::sqrt(expected_squares)));
+		}
+	}
+}
@@ -0,0 +1,194 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include "allocation_counter.hpp"
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <type_traits>
+
+namespace {
+	// A vector type of the user's own, used wherever a euclidean_vector is
+	struct displacement : comp6771::euclidean_vector {
+		using comp6771::euclidean_vector::euclidean_vector;
+	};
+
+	// Not a euclidean_vector, but converts to one
+	struct point {
+		double x;
+		double y;
+		// NOLINTNEXTLINE(google-explicit-constructor)
+		operator comp6771::euclidean_vector() const {
+			return comp6771::euclidean_vector{x, y};
+		}
+	};
+} // namespace
+
+TEST_CASE("Expressions are evaluated only when assigned") {
+	SECTION("A chain does no arithmetic until read") {
+		auto const a = comp6771::euclidean_vector{1, 2, 3};
+		auto const b = comp6771::euclidean_vector{4, 5, 6};
+		auto const e = a + b * 2.0 - a / 2.0;
+		STATIC_REQUIRE(
+		   not std::is_same_v<std::remove_cvref_t<decltype(e)>, comp6771::euclidean_vector>);
+		CHECK(e.dimensions() == 3);
+		CHECK(e[0] == 1 + 4 * 2.0 - 1 / 2.0);
+		CHECK(e[2] == 3 + 6 * 2.0 - 3 / 2.0);
+
+		auto const c = comp6771::euclidean_vector(e);
+		CHECK(c == comp6771::euclidean_vector{8.5, 11, 13.5});
+		CHECK(e == c);
+		CHECK(c == e);
+		CHECK_FALSE(e != c);
+		CHECK(fmt::format("{}", e) == "[8.5 11 13.5]");
+	}
+
+	SECTION("Every operator builds an expression") {
+		auto a = comp6771::euclidean_vector{1, 2, 3};
+		auto const b = comp6771::euclidean_vector{4, 5, 6};
+		auto const sum = a + b;
+		auto const difference = a - b;
+		auto const negated = -a;
+		auto const scaled = 2.0 * a;
+		auto const halved = a / 2.0;
+		STATIC_REQUIRE(comp6771::detail::is_expression_v<decltype(sum)>);
+		STATIC_REQUIRE(comp6771::detail::is_expression_v<decltype(difference)>);
+		STATIC_REQUIRE(comp6771::detail::is_expression_v<decltype(negated)>);
+		STATIC_REQUIRE(comp6771::detail::is_expression_v<decltype(scaled)>);
+		STATIC_REQUIRE(comp6771::detail::is_expression_v<decltype(halved)>);
+
+		// Each reads a when it is evaluated, not when it was built
+		a[0] = 100;
+		CHECK(sum == comp6771::euclidean_vector{104, 7, 9});
+		CHECK(difference == comp6771::euclidean_vector{96, -3, -3});
+		CHECK(negated == comp6771::euclidean_vector{-100, -2, -3});
+		CHECK(scaled == comp6771::euclidean_vector{200, 4, 6});
+		CHECK(halved == comp6771::euclidean_vector{50, 1, 1.5});
+	}
+
+	SECTION("eval() and a vector type give an owned vector") {
+		auto a = comp6771::euclidean_vector{1, 2, 3};
+		auto const b = comp6771::euclidean_vector{4, 5, 6};
+		auto const sum = (a + b).eval();
+		comp6771::euclidean_vector const difference = a - b;
+		STATIC_REQUIRE(std::is_same_v<decltype(sum), comp6771::euclidean_vector const>);
+
+		// Changing an operand afterwards does not reach the result
+		a[0] = 100;
+		CHECK(sum == comp6771::euclidean_vector{5, 7, 9});
+		CHECK(difference == comp6771::euclidean_vector{-3, -3, -3});
+
+		// Nor does the operands going away
+		auto const add = [](double x) {
+			auto const u = comp6771::euclidean_vector{x, x};
+			auto const v = comp6771::euclidean_vector{1, 2};
+			return (u + v).eval();
+		};
+		CHECK(add(3) == comp6771::euclidean_vector{4, 5});
+	}
+
+	SECTION("A lazy chain reads its named operands when evaluated") {
+		auto const a = comp6771::euclidean_vector{1, 2};
+		auto c = comp6771::euclidean_vector{1, 1};
+		auto const e = a + a + c;
+		STATIC_REQUIRE(
+		   not std::is_same_v<std::remove_cvref_t<decltype(e)>, comp6771::euclidean_vector>);
+		c[0] = 10;
+		CHECK(comp6771::euclidean_vector(e) == comp6771::euclidean_vector{12, 5});
+	}
+
+	SECTION("Assigning to an operand of the expression") {
+		auto a = comp6771::euclidean_vector{1, 2, 3};
+		auto const b = comp6771::euclidean_vector{1, 1, 1};
+		auto const* const storage = a.begin();
+		a = a * 2.0 + b;
+		CHECK(a == comp6771::euclidean_vector{3, 5, 7});
+		// Same dimensions, so the result went straight into a's own storage
+		CHECK(a.begin() == storage);
+
+		a = -a + a;
+		CHECK(a == comp6771::euclidean_vector(3, 0.0));
+
+		a = comp6771::euclidean_vector{1, 2};
+		CHECK(a.dimensions() == 2);
+		a = a + a + a;
+		CHECK(a == comp6771::euclidean_vector{3, 6});
+	}
+
+	SECTION("Compound assignment from an expression") {
+		auto a = comp6771::euclidean_vector{1, 2, 3};
+		auto const b = comp6771::euclidean_vector{1, 1, 1};
+		a += b * 3.0;
+		CHECK(a == comp6771::euclidean_vector{4, 5, 6});
+		a -= b + b;
+		CHECK(a == comp6771::euclidean_vector{2, 3, 4});
+		CHECK(comp6771::euclidean_norm(a) == Approx(std::sqrt(29.0)));
+
+		a += a + b;
+		CHECK(a == comp6771::euclidean_vector{5, 7, 9});
+		auto const c = comp6771::euclidean_vector{1, 2};
+		CHECK_THROWS_WITH(a += c * 2.0, "Dimensions of LHS(3) and RHS(2) do not match");
+		CHECK_THROWS_WITH(a -= c * 2.0, "Dimensions of LHS(3) and RHS(2) do not match");
+	}
+
+	SECTION("Temporaries are kept alive by the expression") {
+		auto const b = comp6771::euclidean_vector{1, 2};
+		auto const e = comp6771::euclidean_vector{3, 4} + b;
+		CHECK(comp6771::euclidean_vector(e) == comp6771::euclidean_vector{4, 6});
+		CHECK(comp6771::dot(e, b) == Approx(16));
+	}
+
+	SECTION("Errors are thrown when the expression is built") {
+		auto const a = comp6771::euclidean_vector{1, 2, 3};
+		auto const b = comp6771::euclidean_vector{1, 2};
+		CHECK_THROWS_WITH(a * 2.0 + b, "Dimensions of LHS(3) and RHS(2) do not match");
+		CHECK_THROWS_WITH(b - (a + a), "Dimensions of LHS(2) and RHS(3) do not match");
+		CHECK_THROWS_WITH((a + a) / 0, "Invalid vector division by 0");
+	}
+
+	SECTION("Operands that convert to a euclidean_vector") {
+		auto const a = comp6771::euclidean_vector{1, 2};
+		auto const d = displacement{3, 4};
+		CHECK(comp6771::euclidean_vector(d + a) == comp6771::euclidean_vector{4, 6});
+		CHECK(comp6771::euclidean_vector(a - d) == comp6771::euclidean_vector{-2, -2});
+		CHECK(comp6771::euclidean_vector(d * 2.0) == comp6771::euclidean_vector{6, 8});
+		CHECK(comp6771::euclidean_vector(2.0 * d / 4.0) == comp6771::euclidean_vector{1.5, 2});
+		CHECK(comp6771::euclidean_vector(-d) == comp6771::euclidean_vector{-3, -4});
+		CHECK(d + a == comp6771::euclidean_vector{4, 6});
+
+		auto const p = point{0.5, -1};
+		CHECK(comp6771::euclidean_vector(p + a) == comp6771::euclidean_vector{1.5, 1});
+		CHECK(comp6771::euclidean_vector(a - p) == comp6771::euclidean_vector{0.5, 3});
+		CHECK(comp6771::euclidean_vector(a * 2.0 + p) == comp6771::euclidean_vector{2.5, 3});
+		CHECK(a + p == comp6771::euclidean_vector{1.5, 1});
+		auto const b = comp6771::euclidean_vector(3);
+		CHECK_THROWS_WITH(b + p, "Dimensions of LHS(3) and RHS(2) do not match");
+	}
+}
+
+TEST_CASE("Evaluating an expression into a vector of its size allocates nothing") {
+	// Big enough that each vector's magnitudes are on the heap
+	constexpr auto dimension = 4096;
+	auto const a = comp6771::euclidean_vector(dimension, 1.0);
+	auto const b = comp6771::euclidean_vector(dimension, 2.0);
+	auto const c = comp6771::euclidean_vector(dimension, 3.0);
+	auto d = comp6771::euclidean_vector(dimension);
+
+	auto const before = allocations;
+	d = a + b * 2.0 - c;
+	CHECK(allocations == before);
+	CHECK(d[0] == 2.0);
+	CHECK(d[dimension - 1] == 2.0);
+
+	d = a + b - c;
+	CHECK(allocations == before);
+	CHECK(d[0] == 0.0);
+
+	d += (a + b) + c;
+	CHECK(allocations == before);
+	CHECK(d[0] == 6.0);
+
+	d -= a * 2.0;
+	CHECK(allocations == before);
+	CHECK(d[dimension - 1] == 4.0);
+}
@@ -0,0 +1,55 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include "allocation_counter.hpp"
+
+#include <catch2/catch.hpp>
+#include <utility>
+#include <vector>
+
+TEST_CASE("Low-dimensional vectors keep their magnitudes inline") {
+	SECTION("Small vectors never allocate") {
+		auto const before = allocations;
+		auto const a = comp6771::euclidean_vector();
+		auto const b = comp6771::euclidean_vector(8);
+		auto const c = comp6771::euclidean_vector(3, 1.5);
+		auto const d = comp6771::euclidean_vector{1, 2, 3, 4};
+		auto e = comp6771::euclidean_vector(d);
+		e = c + c * 2.0;
+		auto const f = std::move(e);
+		auto const allocated = allocations - before;
+		CHECK(allocated == 0);
+
+		CHECK(a == comp6771::euclidean_vector{0});
+		CHECK(b == comp6771::euclidean_vector(8, 0.0));
+		CHECK(d[3] == 4);
+		CHECK(f == comp6771::euclidean_vector(3, 4.5));
+		CHECK(e.dimensions() == 0);
+	}
+
+	SECTION("Larger vectors go to the heap") {
+		auto const before = allocations;
+		auto const a = comp6771::euclidean_vector(9, 2.0);
+		CHECK(allocations - before == 1);
+		CHECK(comp6771::euclidean_norm(a) == Approx(6.0));
+	}
+
+	SECTION("Moving and copying across the threshold") {
+		for (auto dim = 1; dim <= 12; ++dim) {
+			auto values = std::vector<double>{};
+			for (auto i = 0; i < dim; ++i) {
+				values.push_back(i * 0.5 - 1);
+			}
+			auto a = comp6771::euclidean_vector(values.begin(), values.end());
+			auto b = std::move(a);
+			CHECK(static_cast<std::vector<double>>(b) == values);
+
+			auto c = comp6771::euclidean_vector(dim % 5 + 1, 7.0);
+			c = b;
+			CHECK(static_cast<std::vector<double>>(c) == values);
+			c = std::move(b);
+			CHECK(static_cast<std::vector<double>>(c) == values);
+			c += c;
+			CHECK(c[dim - 1] == values.back() * 2);
+		}
+	}
+}